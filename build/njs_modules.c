@@ -0,0 +1,22 @@
+
+#include <njs_main.h>
+
+extern njs_module_t  njs_buffer_module;
+extern njs_module_t  njs_crypto_module;
+extern njs_module_t  njs_webcrypto_module;
+extern njs_module_t  njs_xml_module;
+extern njs_module_t  njs_zlib_module;
+extern njs_module_t  njs_fs_module;
+extern njs_module_t  njs_query_string_module;
+
+njs_module_t *njs_modules[] = {
+    &njs_buffer_module,
+    &njs_crypto_module,
+    &njs_webcrypto_module,
+    &njs_xml_module,
+    &njs_zlib_module,
+    &njs_fs_module,
+    &njs_query_string_module,
+    NULL
+};
+
@@ -319,6 +319,16 @@ njs_regex_compile(njs_regex_t *regex, u_char *source, size_t len,
         return NJS_DECLINED;
     }
 
+#ifdef NJS_HAVE_PCRE2_JIT
+
+    /*
+     * Patterns which cannot be JIT compiled (unsupported options,
+     * no executable memory) are still matched by the interpreter.
+     */
+    (void) pcre2_jit_compile(regex->code, PCRE2_JIT_COMPLETE);
+
+#endif
+
     ret = pcre2_pattern_info(regex->code, PCRE2_INFO_CAPTURECOUNT,
                              &regex->ncaptures);
 
@@ -531,6 +541,21 @@ done:
 }
 
 
+void
+njs_regex_free(njs_regex_t *regex)
+{
+#ifdef NJS_HAVE_PCRE2
+
+    /* The JIT code is allocated outside of the memory pool. */
+
+    pcre2_code_free(regex->code);
+
+#endif
+
+    regex->code = NULL;
+}
+
+
 njs_bool_t
 njs_regex_is_valid(njs_regex_t *regex)
 {
@@ -627,12 +652,26 @@ njs_regex_match(njs_regex_t *regex, const u_char *subject, size_t off,
 
     ret = pcre2_match(regex->code, subject, len, off, 0, match_data, NULL);
 
+#ifdef NJS_HAVE_PCRE2_JIT
+
+    if (njs_slow_path(ret == PCRE2_ERROR_JIT_STACKLIMIT)) {
+        /* The default JIT machine stack is exhausted. */
+        ret = pcre2_match(regex->code, subject, len, off, PCRE2_NO_JIT,
+                          match_data, NULL);
+    }
+
+#endif
+
     if (ret < 0) {
         if (ret == PCRE2_ERROR_NOMATCH) {
             return NJS_DECLINED;
         }
 
-        njs_alert(trace, NJS_LEVEL_ERROR, "pcre2_match() failed: %s",
+        /* Failed allocations are reported with the critical level. */
+
+        njs_alert(trace, (ret == PCRE2_ERROR_NOMEMORY) ? NJS_LEVEL_CRIT
+                                                       : NJS_LEVEL_ERROR,
+                  "pcre2_match() failed: %s",
                   njs_regex_pcre2_error(ret, errstr));
         return NJS_ERROR;
     }
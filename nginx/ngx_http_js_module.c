@@ -48,6 +48,9 @@ typedef struct {
 #define NJS_HEADER_ARRAY       0x4
 
 
+#define NGX_HTTP_JS_JSON_BUF_SIZE  16384
+
+
 typedef struct {
     NGX_JS_COMMON_CTX;
     ngx_log_t             *log;
@@ -66,6 +69,9 @@ typedef struct {
     ngx_chain_t           *free;
     ngx_chain_t           *busy;
 
+    ngx_chain_t           *json_free;
+    ngx_chain_t           *json_busy;
+
     ngx_js_periodic_t     *periodic;
 } ngx_http_js_ctx_t;
 
@@ -159,6 +165,10 @@ static njs_int_t ngx_http_js_ext_send_header(njs_vm_t *vm, njs_value_t *args,
     njs_uint_t nargs, njs_index_t unused, njs_value_t *retval);
 static njs_int_t ngx_http_js_ext_send(njs_vm_t *vm, njs_value_t *args,
     njs_uint_t nargs, njs_index_t unused, njs_value_t *retval);
+static njs_int_t ngx_http_js_ext_send_json(njs_vm_t *vm, njs_value_t *args,
+    njs_uint_t nargs, njs_index_t unused, njs_value_t *retval);
+static njs_int_t ngx_http_js_json_writer(njs_vm_t *vm, const u_char *start,
+    size_t size, void *data);
 static njs_int_t ngx_http_js_ext_send_buffer(njs_vm_t *vm, njs_value_t *args,
     njs_uint_t nargs, njs_index_t unused, njs_value_t *retval);
 static njs_int_t ngx_http_js_ext_set_return_value(njs_vm_t *vm,
@@ -174,6 +184,12 @@ static njs_int_t ngx_http_js_ext_internal_redirect(njs_vm_t *vm,
     njs_value_t *args, njs_uint_t nargs, njs_index_t unused,
     njs_value_t *retval);
 
+static njs_int_t ngx_http_js_ext_get_string(njs_vm_t *vm,
+    njs_object_prop_t *prop, njs_value_t *value, njs_value_t *setval,
+    njs_value_t *retval);
+static njs_int_t ngx_http_js_header_string(njs_vm_t *vm,
+    ngx_http_request_t *r, ngx_list_t *headers, njs_value_t *retval,
+    ngx_str_t *str);
 static njs_int_t ngx_http_js_ext_get_http_version(njs_vm_t *vm,
     njs_object_prop_t *prop, njs_value_t *value, njs_value_t *setval,
     njs_value_t *retval);
@@ -376,6 +392,20 @@ static ngx_command_t  ngx_http_js_commands[] = {
       0,
       NULL },
 
+    { ngx_string("js_vm_pool_size"),
+      NGX_HTTP_MAIN_CONF|NGX_HTTP_SRV_CONF|NGX_HTTP_LOC_CONF|NGX_CONF_TAKE1,
+      ngx_conf_set_num_slot,
+      NGX_HTTP_LOC_CONF_OFFSET,
+      offsetof(ngx_http_js_loc_conf_t, vm_pool_size),
+      NULL },
+
+    { ngx_string("js_memory_limit"),
+      NGX_HTTP_MAIN_CONF|NGX_HTTP_SRV_CONF|NGX_HTTP_LOC_CONF|NGX_CONF_TAKE1,
+      ngx_conf_set_size_slot,
+      NGX_HTTP_LOC_CONF_OFFSET,
+      offsetof(ngx_http_js_loc_conf_t, memory_limit),
+      NULL },
+
     { ngx_string("js_fetch_buffer_size"),
       NGX_HTTP_MAIN_CONF|NGX_HTTP_SRV_CONF|NGX_HTTP_LOC_CONF|NGX_CONF_TAKE1,
       ngx_conf_set_size_slot,
@@ -609,7 +639,7 @@ static njs_external_t  ngx_http_js_ext_request[] = {
         .name.string = njs_str("method"),
         .enumerable = 1,
         .u.property = {
-            .handler = ngx_js_ext_string,
+            .handler = ngx_http_js_ext_get_string,
             .magic32 = offsetof(ngx_http_request_t, method_name),
         }
     },
@@ -719,6 +749,17 @@ static njs_external_t  ngx_http_js_ext_request[] = {
         }
     },
 
+    {
+        .flags = NJS_EXTERN_METHOD,
+        .name.string = njs_str("sendJSON"),
+        .writable = 1,
+        .configurable = 1,
+        .enumerable = 1,
+        .u.method = {
+            .native = ngx_http_js_ext_send_json,
+        }
+    },
+
     {
         .flags = NJS_EXTERN_METHOD,
         .name.string = njs_str("sendBuffer"),
@@ -778,7 +819,7 @@ static njs_external_t  ngx_http_js_ext_request[] = {
         .name.string = njs_str("uri"),
         .enumerable = 1,
         .u.property = {
-            .handler = ngx_js_ext_string,
+            .handler = ngx_http_js_ext_get_string,
             .magic32 = offsetof(ngx_http_request_t, uri),
         }
     },
@@ -1164,14 +1205,25 @@ ngx_http_js_body_filter(ngx_http_request_t *r, ngx_chain_t *in)
         if (!ctx->done) {
             len = b->last - b->pos;
 
-            p = ngx_pnalloc(r->pool, len);
-            if (p == NULL) {
-                njs_vm_memory_error(ctx->vm);
-                return NJS_ERROR;
-            }
+            /*
+             * A string value is created from a copy in the VM memory,
+             * while a Buffer value references the data which is copied
+             * to the request pool to outlive the buffer.
+             */
+
+            if (jlcf->buffer_type == NGX_JS_STRING && len) {
+                p = b->pos;
 
-            if (len) {
-                ngx_memcpy(p, b->pos, len);
+            } else {
+                p = ngx_pnalloc(r->pool, len);
+                if (p == NULL) {
+                    njs_vm_memory_error(ctx->vm);
+                    return NJS_ERROR;
+                }
+
+                if (len) {
+                    ngx_memcpy(p, b->pos, len);
+                }
             }
 
             ret = ngx_js_prop(ctx->vm, jlcf->buffer_type,
@@ -1365,8 +1417,9 @@ ngx_http_js_init_vm(ngx_http_request_t *r, njs_int_t proto_id)
         return NGX_OK;
     }
 
-    ctx->vm = njs_vm_clone(jlcf->vm, r);
-    if (ctx->vm == NULL) {
+    if (ngx_js_ctx_vm((ngx_js_ctx_t *) ctx, (ngx_js_loc_conf_t *) jlcf, r)
+        == NULL)
+    {
         return NGX_ERROR;
     }
 
@@ -1487,7 +1540,7 @@ ngx_http_js_ext_keys_header(njs_vm_t *vm, njs_value_t *value, njs_value_t *keys,
                 return NJS_ERROR;
             }
 
-            rc = njs_vm_value_string_create(vm, value, h->key.data, h->key.len);
+            rc = njs_vm_value_string_intern(vm, value, h->key.data, h->key.len);
             if (rc != NJS_OK) {
                 return NJS_ERROR;
             }
@@ -1537,6 +1590,24 @@ ngx_http_js_get_header(ngx_list_part_t *part, u_char *data, size_t len)
 #endif
 
 
+static njs_int_t
+ngx_http_js_header_string(njs_vm_t *vm, ngx_http_request_t *r,
+    ngx_list_t *headers, njs_value_t *retval, ngx_str_t *str)
+{
+    /*
+     * Request headers are not changed once read and are referenced
+     * without copying.  Response headers are copied, as they may point
+     * into the upstream buffer, which is reused for the response body.
+     */
+
+    if (headers == &r->headers_in.headers) {
+        return njs_vm_value_string_external(vm, retval, str->data, str->len);
+    }
+
+    return njs_vm_value_string_create(vm, retval, str->data, str->len);
+}
+
+
 static njs_int_t
 ngx_http_js_ext_raw_header(njs_vm_t *vm, njs_object_prop_t *prop,
     njs_value_t *value, njs_value_t *setval, njs_value_t *retval)
@@ -1599,7 +1670,7 @@ ngx_http_js_ext_raw_header(njs_vm_t *vm, njs_object_prop_t *prop,
             return NJS_ERROR;
         }
 
-        rc = njs_vm_value_string_create(vm, elem, h->key.data, h->key.len);
+        rc = ngx_http_js_header_string(vm, r, headers, elem, &h->key);
         if (rc != NJS_OK) {
             return NJS_ERROR;
         }
@@ -1609,7 +1680,7 @@ ngx_http_js_ext_raw_header(njs_vm_t *vm, njs_object_prop_t *prop,
             return NJS_ERROR;
         }
 
-        rc = njs_vm_value_string_create(vm, elem, h->value.data, h->value.len);
+        rc = ngx_http_js_header_string(vm, r, headers, elem, &h->value);
         if (rc != NJS_OK) {
             return NJS_ERROR;
         }
@@ -1726,8 +1797,7 @@ ngx_http_js_header_single(njs_vm_t *vm, ngx_http_request_t *r,
             return NJS_DECLINED;
         }
 
-        rc = njs_vm_value_string_create(vm, retval, h->value.data,
-                                        h->value.len);
+        rc = ngx_http_js_header_string(vm, r, headers, retval, &h->value);
         if (rc != NJS_OK) {
             return NJS_ERROR;
         }
@@ -1869,8 +1939,7 @@ ngx_http_js_header_array(njs_vm_t *vm, ngx_http_request_t *r,
                 return NJS_ERROR;
             }
 
-            rc = njs_vm_value_string_create(vm, value, h->value.data,
-                                            h->value.len);
+            rc = ngx_http_js_header_string(vm, r, headers, value, &h->value);
             if (rc != NJS_OK) {
                 return NJS_ERROR;
             }
@@ -2290,6 +2359,100 @@ ngx_http_js_ext_send(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
 }
 
 
+static njs_int_t
+ngx_http_js_ext_send_json(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
+    njs_index_t unused, njs_value_t *retval)
+{
+    ngx_http_js_ctx_t   *ctx;
+    ngx_http_request_t  *r;
+
+    r = njs_vm_external(vm, ngx_http_js_request_proto_id,
+                        njs_argument(args, 0));
+    if (r == NULL) {
+        njs_vm_error(vm, "\"this\" is not an external");
+        return NJS_ERROR;
+    }
+
+    ctx = ngx_http_get_module_ctx(r, ngx_http_js_module);
+
+    if (ctx->filter) {
+        njs_vm_error(vm, "cannot send while in body filter");
+        return NJS_ERROR;
+    }
+
+    /*
+     * The value is serialized in parts, each part is copied into
+     * a response buffer which is reused once it is sent.
+     */
+
+    if (njs_vm_json_stringify_to(vm, njs_argument(args, 1), nargs - 1,
+                                 ngx_http_js_json_writer, r)
+        != NJS_OK)
+    {
+        return NJS_ERROR;
+    }
+
+    njs_value_undefined_set(retval);
+
+    return NJS_OK;
+}
+
+
+static njs_int_t
+ngx_http_js_json_writer(njs_vm_t *vm, const u_char *start, size_t size,
+    void *data)
+{
+    size_t               n;
+    ngx_buf_t           *b;
+    ngx_chain_t         *out;
+    ngx_http_js_ctx_t   *ctx;
+    ngx_http_request_t  *r;
+
+    r = data;
+    ctx = ngx_http_get_module_ctx(r, ngx_http_js_module);
+
+    out = ngx_chain_get_free_buf(r->pool, &ctx->json_free);
+    if (out == NULL) {
+        njs_vm_memory_error(vm);
+        return NJS_ERROR;
+    }
+
+    b = out->buf;
+
+    if ((size_t) (b->end - b->start) < size) {
+        if (b->start != NULL) {
+            ngx_pfree(r->pool, b->start);
+        }
+
+        n = ngx_max(size, NGX_HTTP_JS_JSON_BUF_SIZE);
+
+        b->start = ngx_palloc(r->pool, n);
+        if (b->start == NULL) {
+            njs_vm_memory_error(vm);
+            return NJS_ERROR;
+        }
+
+        b->end = b->start + n;
+    }
+
+    b->pos = b->start;
+    b->last = ngx_cpymem(b->pos, start, size);
+
+    b->temporary = 1;
+    b->tag = (ngx_buf_tag_t) &ngx_http_js_module;
+
+    if (ngx_http_output_filter(r, out) == NGX_ERROR) {
+        njs_vm_error(vm, "failed to send response");
+        return NJS_ERROR;
+    }
+
+    ngx_chain_update_chains(r->pool, &ctx->json_free, &ctx->json_busy, &out,
+                            (ngx_buf_tag_t) &ngx_http_js_module);
+
+    return NJS_OK;
+}
+
+
 static njs_int_t
 ngx_http_js_ext_send_buffer(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
     njs_index_t unused, njs_value_t *retval)
@@ -2555,6 +2718,31 @@ ngx_http_js_ext_internal_redirect(njs_vm_t *vm, njs_value_t *args,
 }
 
 
+static njs_int_t
+ngx_http_js_ext_get_string(njs_vm_t *vm, njs_object_prop_t *prop,
+    njs_value_t *value, njs_value_t *setval, njs_value_t *retval)
+{
+    ngx_str_t           *field;
+    ngx_http_request_t  *r;
+
+    r = njs_vm_external(vm, ngx_http_js_request_proto_id, value);
+    if (r == NULL) {
+        njs_value_undefined_set(retval);
+        return NJS_DECLINED;
+    }
+
+    /*
+     * The method and URI are not changed in place, an internal redirect
+     * sets a new URI and leaves the old data intact until the request
+     * is freed, after the VM.
+     */
+
+    field = (ngx_str_t *) ((u_char *) r + njs_vm_prop_magic32(prop));
+
+    return njs_vm_value_string_external(vm, retval, field->data, field->len);
+}
+
+
 static njs_int_t
 ngx_http_js_ext_get_http_version(njs_vm_t *vm, njs_object_prop_t *prop,
     njs_value_t *value, njs_value_t *setval, njs_value_t *retval)
@@ -2751,7 +2939,9 @@ ngx_http_js_ext_get_request_body(njs_vm_t *vm, njs_object_prop_t *prop,
 
 done:
 
-    ret = ngx_js_prop(vm, buffer_type, request_body, body, len);
+    /* The request body buffers are not changed once the body is read. */
+
+    ret = ngx_js_prop_external(vm, buffer_type, request_body, body, len);
     if (ret != NJS_OK) {
         return NJS_ERROR;
     }
@@ -2860,8 +3050,8 @@ ngx_http_js_header_in_array(njs_vm_t *vm, ngx_http_request_t *r,
     }
 
     if (n == 1) {
-        return njs_vm_value_string_create(vm, retval, (*hh)->value.data,
-                                              (*hh)->value.len);
+        return njs_vm_value_string_external(vm, retval, (*hh)->value.data,
+                                            (*hh)->value.len);
     }
 
     NJS_CHB_MP_INIT(&chain, vm);
@@ -3865,8 +4055,7 @@ ngx_http_js_header_generic(njs_vm_t *vm, ngx_http_request_t *r,
                 return NJS_ERROR;
             }
 
-            rc = njs_vm_value_string_create(vm, value, h->value.data,
-                                            h->value.len);
+            rc = ngx_http_js_header_string(vm, r, headers, value, &h->value);
             if (rc != NJS_OK) {
                 return NJS_ERROR;
             }
@@ -3876,8 +4065,8 @@ ngx_http_js_header_generic(njs_vm_t *vm, ngx_http_request_t *r,
     }
 
     if ((*ph)->next == NULL || flags & NJS_HEADER_SINGLE) {
-        return njs_vm_value_string_create(vm, retval, (*ph)->value.data,
-                                          (*ph)->value.len);
+        return ngx_http_js_header_string(vm, r, headers, retval,
+                                         &(*ph)->value);
     }
 
     NJS_CHB_MP_INIT(&chain, vm);
@@ -43,6 +43,12 @@ typedef struct {
 } njs_module_info_t;
 
 
+typedef struct {
+    ngx_js_loc_conf_t   *conf;
+    ngx_int_t          (*init_vm)(ngx_conf_t *cf, ngx_js_loc_conf_t *conf);
+} ngx_js_conf_vm_t;
+
+
 static njs_int_t ngx_js_ext_build(njs_vm_t *vm, njs_object_prop_t *prop,
     njs_value_t *value, njs_value_t *setval, njs_value_t *retval);
 static njs_int_t ngx_js_ext_conf_file_path(njs_vm_t *vm,
@@ -71,6 +77,16 @@ static njs_int_t njs_clear_timeout(njs_vm_t *vm, njs_value_t *args,
     njs_uint_t nargs, njs_index_t unused, njs_value_t *retval);
 static njs_int_t ngx_js_unhandled_rejection(ngx_js_ctx_t *ctx);
 static void ngx_js_cleanup_vm(void *data);
+static ngx_int_t ngx_js_named_paths_eq(ngx_array_t *a, ngx_array_t *b);
+static ngx_int_t ngx_js_paths_eq(ngx_array_t *a, ngx_array_t *b);
+static ngx_js_loc_conf_t *ngx_js_find_conf_vm(ngx_conf_t *cf,
+    ngx_js_loc_conf_t *conf,
+    ngx_int_t (*init_vm)(ngx_conf_t *cf, ngx_js_loc_conf_t *conf));
+static ngx_int_t ngx_js_add_conf_vm(ngx_conf_t *cf, ngx_js_loc_conf_t *conf,
+    ngx_int_t (*init_vm)(ngx_conf_t *cf, ngx_js_loc_conf_t *conf));
+static void ngx_js_cleanup_conf_vms(void *data);
+static ngx_int_t ngx_js_init_vm_pool(ngx_conf_t *cf, ngx_js_loc_conf_t *conf);
+static void ngx_js_cleanup_vm_pool(void *data);
 
 static njs_int_t ngx_js_core_init(njs_vm_t *vm);
 static uint64_t ngx_js_monotonic_time(void);
@@ -353,6 +369,10 @@ njs_module_t *njs_js_addon_modules_shared[] = {
 
 static njs_int_t      ngx_js_console_proto_id;
 
+/* VMs created for the configuration being parsed. */
+static ngx_array_t   *ngx_js_conf_vms;
+static ngx_cycle_t   *ngx_js_conf_vms_cycle;
+
 
 ngx_int_t
 ngx_js_call(njs_vm_t *vm, njs_function_t *func, njs_value_t *args,
@@ -561,12 +581,69 @@ ngx_js_ctx_init(ngx_js_ctx_t *ctx)
 }
 
 
+njs_vm_t *
+ngx_js_ctx_vm(ngx_js_ctx_t *ctx, ngx_js_loc_conf_t *conf,
+    njs_external_ptr_t external)
+{
+    njs_mp_t          *mp;
+    njs_vm_t          *vm;
+    njs_mp_stat_t      stat;
+    njs_vm_opt_t      *options;
+    ngx_js_vm_pool_t  *pool;
+
+    pool = conf->vm_pool;
+
+    if (pool != NULL && pool->nfree != 0) {
+        vm = pool->free[--pool->nfree];
+        njs_vm_external_ptr_set(vm, external);
+
+    } else {
+        vm = njs_vm_clone(conf->vm, external);
+    }
+
+    if (vm != NULL && (conf->memory_limit != 0 || pool != NULL)) {
+
+        /*
+         * The limit is counted from the memory the clone starts with.
+         * Data allocations beyond it fail with MemoryError, a quarter
+         * more is reserved to handle the error.
+         */
+
+        mp = njs_vm_memory_pool(vm);
+
+        if (conf->memory_limit != 0) {
+            njs_mp_stat(mp, &stat);
+            njs_mp_limit(mp, stat.size + conf->memory_limit,
+                         stat.size + conf->memory_limit
+                         + conf->memory_limit / 4);
+
+        } else {
+            /* A pooled clone may be limited by another location. */
+            options = njs_vm_options(vm);
+            njs_mp_limit(mp, options->memory_soft_limit,
+                         options->memory_limit);
+        }
+    }
+
+    ctx->vm = vm;
+    ctx->vm_pool = pool;
+
+    return vm;
+}
+
+
 void
 ngx_js_ctx_destroy(ngx_js_ctx_t *ctx)
 {
+    njs_vm_t           *vm;
+    ngx_uint_t          pending;
+    njs_mp_stat_t       stat;
     ngx_js_event_t     *event;
+    ngx_js_vm_pool_t   *pool;
     njs_rbtree_node_t  *node;
 
+    pending = ngx_vm_pending(ctx);
+
     node = njs_rbtree_min(&ctx->waiting_events);
 
     while (njs_rbtree_is_there_successor(&ctx->waiting_events, node)) {
@@ -580,6 +657,28 @@ ngx_js_ctx_destroy(ngx_js_ctx_t *ctx)
         node = njs_rbtree_node_successor(&ctx->waiting_events, node);
     }
 
+    pool = ctx->vm_pool;
+
+    if (pool != NULL && pool->nfree < pool->size && !pending) {
+
+        /*
+         * A clone is returned to the pool with its memory pool reset,
+         * so the next request reuses the warmed up pool pages.  Clones
+         * which have grown too large are destroyed instead.
+         */
+
+        njs_mp_stat(njs_vm_memory_pool(ctx->vm), &stat);
+
+        if (stat.size <= NGX_JS_VM_POOL_MAX_SIZE) {
+            vm = njs_vm_recycle(pool->vm, ctx->vm, NULL);
+            if (vm != NULL) {
+                pool->free[pool->nfree++] = vm;
+            }
+
+            return;
+        }
+    }
+
     njs_vm_destroy(ctx->vm);
 }
 
@@ -1549,6 +1648,7 @@ ngx_js_merge_vm(ngx_conf_t *cf, ngx_js_loc_conf_t *conf,
     ngx_str_t            *path, *s;
     ngx_uint_t            i;
     ngx_array_t          *imports, *preload_objects, *paths;
+    ngx_js_loc_conf_t    *same;
     ngx_js_named_path_t  *import, *pi, *pij, *preload;
 
     if (conf->imports == NGX_CONF_UNSET_PTR
@@ -1560,6 +1660,7 @@ ngx_js_merge_vm(ngx_conf_t *cf, ngx_js_loc_conf_t *conf,
             conf->imports = prev->imports;
             conf->paths = prev->paths;
             conf->vm = prev->vm;
+            conf->vm_pool = prev->vm_pool;
 
             conf->preload_vm = prev->preload_vm;
 
@@ -1681,7 +1782,177 @@ ngx_js_merge_vm(ngx_conf_t *cf, ngx_js_loc_conf_t *conf,
         return NGX_OK;
     }
 
-    return init_vm(cf, (ngx_js_loc_conf_t *) conf);
+    /*
+     * Levels which repeat the same js_import, js_path and js_preload_object
+     * directives share a single VM instead of compiling the same modules
+     * once again.
+     */
+
+    same = ngx_js_find_conf_vm(cf, conf, init_vm);
+
+    if (same != NULL) {
+        conf->preload_objects = same->preload_objects;
+        conf->imports = same->imports;
+        conf->paths = same->paths;
+        conf->vm = same->vm;
+        conf->vm_pool = same->vm_pool;
+
+        conf->preload_vm = same->preload_vm;
+
+        return NGX_OK;
+    }
+
+    if (init_vm(cf, (ngx_js_loc_conf_t *) conf) != NGX_OK) {
+        return NGX_ERROR;
+    }
+
+    return ngx_js_add_conf_vm(cf, conf, init_vm);
+}
+
+
+static ngx_int_t
+ngx_js_named_paths_eq(ngx_array_t *a, ngx_array_t *b)
+{
+    ngx_uint_t            i;
+    ngx_js_named_path_t  *pa, *pb;
+
+    if (a == b) {
+        return 1;
+    }
+
+    if (a == NGX_CONF_UNSET_PTR
+        || b == NGX_CONF_UNSET_PTR
+        || a->nelts != b->nelts)
+    {
+        return 0;
+    }
+
+    pa = a->elts;
+    pb = b->elts;
+
+    for (i = 0; i < a->nelts; i++) {
+        if (pa[i].name.len != pb[i].name.len
+            || pa[i].path.len != pb[i].path.len
+            || ngx_strncmp(pa[i].name.data, pb[i].name.data, pa[i].name.len)
+               != 0
+            || ngx_strncmp(pa[i].path.data, pb[i].path.data, pa[i].path.len)
+               != 0)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+static ngx_int_t
+ngx_js_paths_eq(ngx_array_t *a, ngx_array_t *b)
+{
+    ngx_str_t   *sa, *sb;
+    ngx_uint_t   i;
+
+    if (a == b) {
+        return 1;
+    }
+
+    if (a == NGX_CONF_UNSET_PTR
+        || b == NGX_CONF_UNSET_PTR
+        || a->nelts != b->nelts)
+    {
+        return 0;
+    }
+
+    sa = a->elts;
+    sb = b->elts;
+
+    for (i = 0; i < a->nelts; i++) {
+        if (sa[i].len != sb[i].len
+            || ngx_strncmp(sa[i].data, sb[i].data, sa[i].len) != 0)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+static ngx_js_loc_conf_t *
+ngx_js_find_conf_vm(ngx_conf_t *cf, ngx_js_loc_conf_t *conf,
+    ngx_int_t (*init_vm)(ngx_conf_t *cf, ngx_js_loc_conf_t *conf))
+{
+    ngx_uint_t          i;
+    ngx_js_conf_vm_t   *cvm;
+    ngx_js_loc_conf_t  *same;
+
+    if (ngx_js_conf_vms == NULL || ngx_js_conf_vms_cycle != cf->cycle) {
+        return NULL;
+    }
+
+    cvm = ngx_js_conf_vms->elts;
+
+    for (i = 0; i < ngx_js_conf_vms->nelts; i++) {
+        same = cvm[i].conf;
+
+        if (cvm[i].init_vm == init_vm
+            && ngx_js_named_paths_eq(same->imports, conf->imports)
+            && ngx_js_named_paths_eq(same->preload_objects,
+                                     conf->preload_objects)
+            && ngx_js_paths_eq(same->paths, conf->paths))
+        {
+            return same;
+        }
+    }
+
+    return NULL;
+}
+
+
+static ngx_int_t
+ngx_js_add_conf_vm(ngx_conf_t *cf, ngx_js_loc_conf_t *conf,
+    ngx_int_t (*init_vm)(ngx_conf_t *cf, ngx_js_loc_conf_t *conf))
+{
+    ngx_js_conf_vm_t    *cvm;
+    ngx_pool_cleanup_t  *cln;
+
+    if (ngx_js_conf_vms == NULL || ngx_js_conf_vms_cycle != cf->cycle) {
+        cln = ngx_pool_cleanup_add(cf->pool, 0);
+        if (cln == NULL) {
+            return NGX_ERROR;
+        }
+
+        ngx_js_conf_vms = ngx_array_create(cf->pool, 4,
+                                           sizeof(ngx_js_conf_vm_t));
+        if (ngx_js_conf_vms == NULL) {
+            return NGX_ERROR;
+        }
+
+        ngx_js_conf_vms_cycle = cf->cycle;
+
+        cln->handler = ngx_js_cleanup_conf_vms;
+        cln->data = ngx_js_conf_vms;
+    }
+
+    cvm = ngx_array_push(ngx_js_conf_vms);
+    if (cvm == NULL) {
+        return NGX_ERROR;
+    }
+
+    cvm->conf = conf;
+    cvm->init_vm = init_vm;
+
+    return NGX_OK;
+}
+
+
+static void
+ngx_js_cleanup_conf_vms(void *data)
+{
+    if (ngx_js_conf_vms == data) {
+        ngx_js_conf_vms = NULL;
+        ngx_js_conf_vms_cycle = NULL;
+    }
 }
 
 
@@ -2176,6 +2447,72 @@ ngx_js_cleanup_vm(void *data)
 }
 
 
+/*
+ * A level shares the pool of the level it takes the VM from if the pool
+ * sizes match, otherwise it gets its own pool.  So js_vm_pool_size also
+ * works at levels without their own js_import.
+ */
+
+static ngx_int_t
+ngx_js_init_vm_pool(ngx_conf_t *cf, ngx_js_loc_conf_t *conf)
+{
+    ngx_js_vm_pool_t    *pool;
+    ngx_pool_cleanup_t  *cln;
+
+    if (conf->vm == NULL || conf->vm_pool_size == 0) {
+        conf->vm_pool = NULL;
+        return NGX_OK;
+    }
+
+    pool = conf->vm_pool;
+
+    if (pool != NULL && pool->vm == conf->vm
+        && pool->size == conf->vm_pool_size)
+    {
+        return NGX_OK;
+    }
+
+    pool = ngx_pcalloc(cf->pool, sizeof(ngx_js_vm_pool_t));
+    if (pool == NULL) {
+        return NGX_ERROR;
+    }
+
+    pool->free = ngx_palloc(cf->pool, conf->vm_pool_size * sizeof(njs_vm_t *));
+    if (pool->free == NULL) {
+        return NGX_ERROR;
+    }
+
+    pool->vm = conf->vm;
+    pool->size = conf->vm_pool_size;
+
+    /* Cleanup handlers run in reverse order, before the VM is destroyed. */
+
+    cln = ngx_pool_cleanup_add(cf->pool, 0);
+    if (cln == NULL) {
+        return NGX_ERROR;
+    }
+
+    cln->handler = ngx_js_cleanup_vm_pool;
+    cln->data = pool;
+
+    conf->vm_pool = pool;
+
+    return NGX_OK;
+}
+
+
+static void
+ngx_js_cleanup_vm_pool(void *data)
+{
+    ngx_uint_t         i;
+    ngx_js_vm_pool_t  *pool = data;
+
+    for (i = 0; i < pool->nfree; i++) {
+        njs_vm_destroy(pool->free[i]);
+    }
+}
+
+
 ngx_js_loc_conf_t *
 ngx_js_create_conf(ngx_conf_t *cf, size_t size)
 {
@@ -2189,6 +2526,8 @@ ngx_js_create_conf(ngx_conf_t *cf, size_t size)
     conf->paths = NGX_CONF_UNSET_PTR;
     conf->imports = NGX_CONF_UNSET_PTR;
     conf->preload_objects = NGX_CONF_UNSET_PTR;
+    conf->vm_pool_size = NGX_CONF_UNSET_UINT;
+    conf->memory_limit = NGX_CONF_UNSET_SIZE;
 
     conf->buffer_size = NGX_CONF_UNSET_SIZE;
     conf->max_response_body_size = NGX_CONF_UNSET_SIZE;
@@ -2255,6 +2594,8 @@ ngx_js_merge_conf(ngx_conf_t *cf, void *parent, void *child,
     ngx_conf_merge_size_value(conf->buffer_size, prev->buffer_size, 16384);
     ngx_conf_merge_size_value(conf->max_response_body_size,
                               prev->max_response_body_size, 1048576);
+    ngx_conf_merge_uint_value(conf->vm_pool_size, prev->vm_pool_size, 0);
+    ngx_conf_merge_size_value(conf->memory_limit, prev->memory_limit, 0);
 
     if (ngx_js_merge_vm(cf, (ngx_js_loc_conf_t *) conf,
                         (ngx_js_loc_conf_t *) prev,
@@ -2264,6 +2605,10 @@ ngx_js_merge_conf(ngx_conf_t *cf, void *parent, void *child,
         return NGX_CONF_ERROR;
     }
 
+    if (ngx_js_init_vm_pool(cf, (ngx_js_loc_conf_t *) conf) != NGX_OK) {
+        return NGX_CONF_ERROR;
+    }
+
 #if defined(NGX_HTTP_SSL) || defined(NGX_STREAM_SSL)
     ngx_conf_merge_str_value(conf->ssl_ciphers, prev->ssl_ciphers,
                              "DEFAULT");
@@ -33,6 +33,8 @@
 
 #define NGX_NJS_VAR_NOCACHE 1
 
+#define NGX_JS_VM_POOL_MAX_SIZE  (1024 * 1024)
+
 #define ngx_js_buffer_type(btype) ((btype) & ~NGX_JS_DEPRECATED)
 
 
@@ -59,6 +61,15 @@ typedef struct {
 } ngx_js_named_path_t;
 
 
+typedef struct {
+    /* The VM the pooled clones are cloned from. */
+    njs_vm_t              *vm;
+    njs_vm_t             **free;
+    ngx_uint_t             nfree;
+    ngx_uint_t             size;
+} ngx_js_vm_pool_t;
+
+
 struct ngx_js_event_s {
     njs_vm_t            *vm;
     njs_function_t      *function;
@@ -87,6 +98,10 @@ struct ngx_js_event_s {
     njs_vm_t              *preload_vm;                                        \
     ngx_array_t           *preload_objects;                                   \
                                                                               \
+    ngx_uint_t             vm_pool_size;                                      \
+    ngx_js_vm_pool_t      *vm_pool;                                           \
+    size_t                 memory_limit;                                      \
+                                                                              \
     size_t                 buffer_size;                                       \
     size_t                 max_response_body_size;                            \
     ngx_msec_t             timeout
@@ -110,6 +125,7 @@ struct ngx_js_event_s {
 
 #define NGX_JS_COMMON_CTX                                                     \
     njs_vm_t              *vm;                                                \
+    ngx_js_vm_pool_t      *vm_pool;                                           \
     njs_arr_t             *rejected_promises;                                 \
     njs_rbtree_t           waiting_events;                                    \
     ngx_socket_t           event_id
@@ -182,11 +198,24 @@ struct ngx_js_ctx_s {
                              : njs_vm_value_buffer_set(vm, value, start, len))
 
 
+/*
+ * ngx_js_prop_external() does not copy strings, the data must
+ * outlive the VM and must not be changed while it exists.
+ */
+
+#define ngx_js_prop_external(vm, type, value, start, len)                     \
+    ((type == NGX_JS_STRING)                                                  \
+     ? njs_vm_value_string_external(vm, value, start, len)                    \
+     : njs_vm_value_buffer_set(vm, value, start, len))
+
+
 #define ngx_vm_pending(ctx)                                                   \
     (njs_vm_pending((ctx)->vm) || !njs_rbtree_is_empty(&(ctx)->waiting_events))
 
 
 void ngx_js_ctx_init(ngx_js_ctx_t *ctx);
+njs_vm_t *ngx_js_ctx_vm(ngx_js_ctx_t *ctx, ngx_js_loc_conf_t *conf,
+    njs_external_ptr_t external);
 void ngx_js_ctx_destroy(ngx_js_ctx_t *ctx);
 ngx_int_t ngx_js_call(njs_vm_t *vm, njs_function_t *func, njs_value_t *args,
     njs_uint_t nargs);
@@ -3563,7 +3563,7 @@ ngx_headers_js_ext_keys(njs_vm_t *vm, njs_value_t *value, njs_value_t *keys)
                 return NJS_ERROR;
             }
 
-            rc = njs_vm_value_string_create(vm, value, h[i].key.data,
+            rc = njs_vm_value_string_intern(vm, value, h[i].key.data,
                                             h[i].key.len);
             if (rc != NJS_OK) {
                 return NJS_ERROR;
@@ -3974,7 +3974,7 @@ ngx_response_js_ext_status_text(njs_vm_t *vm, njs_object_prop_t *prop,
         return NJS_DECLINED;
     }
 
-    njs_vm_value_string_create(vm, retval, response->status_text.start,
+    njs_vm_value_string_intern(vm, retval, response->status_text.start,
                                response->status_text.length);
 
     return NJS_OK;
@@ -11,6 +11,12 @@
 
 #define NJS_HAVE_PCRE2  1
 
+#if (NGX_HAVE_PCRE_JIT)
+
+#define NJS_HAVE_PCRE2_JIT  1
+
+#endif
+
 #endif
 
 #include "../external/njs_regex.c"
@@ -233,6 +233,20 @@ static ngx_command_t  ngx_stream_js_commands[] = {
       offsetof(ngx_stream_js_srv_conf_t, filter),
       NULL },
 
+    { ngx_string("js_vm_pool_size"),
+      NGX_STREAM_MAIN_CONF|NGX_STREAM_SRV_CONF|NGX_CONF_TAKE1,
+      ngx_conf_set_num_slot,
+      NGX_STREAM_SRV_CONF_OFFSET,
+      offsetof(ngx_stream_js_srv_conf_t, vm_pool_size),
+      NULL },
+
+    { ngx_string("js_memory_limit"),
+      NGX_STREAM_MAIN_CONF|NGX_STREAM_SRV_CONF|NGX_CONF_TAKE1,
+      ngx_conf_set_size_slot,
+      NGX_STREAM_SRV_CONF_OFFSET,
+      offsetof(ngx_stream_js_srv_conf_t, memory_limit),
+      NULL },
+
     { ngx_string("js_fetch_buffer_size"),
       NGX_STREAM_MAIN_CONF|NGX_STREAM_SRV_CONF|NGX_CONF_TAKE1,
       ngx_conf_set_size_slot,
@@ -1011,8 +1025,9 @@ ngx_stream_js_init_vm(ngx_stream_session_t *s, njs_int_t proto_id)
         return NGX_OK;
     }
 
-    ctx->vm = njs_vm_clone(jscf->vm, s);
-    if (ctx->vm == NULL) {
+    if (ngx_js_ctx_vm((ngx_js_ctx_t *) ctx, (ngx_js_loc_conf_t *) jscf, s)
+        == NULL)
+    {
         return NGX_ERROR;
     }
 
@@ -1122,14 +1137,25 @@ ngx_stream_js_run_event(ngx_stream_session_t *s, ngx_stream_js_ctx_t *ctx,
 
     len = b ? b->last - b->pos : 0;
 
-    p = ngx_pnalloc(c->pool, len);
-    if (p == NULL) {
-        njs_vm_memory_error(ctx->vm);
-        return NJS_ERROR;
-    }
+    /*
+     * The session may last long, so the data is copied to the connection
+     * pool only for a Buffer value which references it, a string value
+     * is created from a copy in the VM memory.
+     */
+
+    if (event->data_type == NGX_JS_STRING && len) {
+        p = b->pos;
 
-    if (len) {
-        ngx_memcpy(p, b->pos, len);
+    } else {
+        p = ngx_pnalloc(c->pool, len);
+        if (p == NULL) {
+            njs_vm_memory_error(ctx->vm);
+            return NJS_ERROR;
+        }
+
+        if (len) {
+            ngx_memcpy(p, b->pos, len);
+        }
     }
 
     ret = ngx_js_prop(ctx->vm, event->data_type, njs_value_arg(&ctx->args[1]),
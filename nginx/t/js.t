@@ -116,6 +116,10 @@ http {
             js_content test.send_buffer;
         }
 
+        location /send_json {
+            js_content test.send_json;
+        }
+
         location /return_method {
             js_content test.return_method;
         }
@@ -230,6 +234,14 @@ $t->write_file('test.js', <<EOF);
         r.finish();
     }
 
+    function send_json(r) {
+        var a = Array(Number(r.args.n)).fill({k: 'value', s: 'x"y'});
+        r.status = 200;
+        r.sendHeader();
+        r.sendJSON({n: a.length, a: a});
+        r.finish();
+    }
+
     function return_method(r) {
         r.return(Number(r.args.c), r.args.t);
     }
@@ -274,11 +286,11 @@ $t->write_file('test.js', <<EOF);
                     variable, global_obj, status, request_body, internal,
                     request_body_cache, send, return_method, sub_internal,
                     type, log, buffer_variable, except, content_except,
-                    content_empty, send_buffer};
+                    content_empty, send_buffer, send_json};
 
 EOF
 
-$t->try_run('no njs available')->plan(29);
+$t->try_run('no njs available')->plan(32);
 
 ###############################################################################
 
@@ -286,6 +298,8 @@ like(http_get('/method'), qr/method=GET/, 'r.method');
 like(http_get('/version'), qr/version=1.0/, 'r.httpVersion');
 like(http_get('/addr'), qr/addr=127.0.0.1/, 'r.remoteAddress');
 like(http_get('/uri'), qr/uri=\/uri/, 'r.uri');
+like(http_get('/uri/long/path/to/resource'),
+	qr/uri=\/uri\/long\/path\/to\/resource/, 'r.uri long');
 
 like(http_get('/status'), qr/204 No Content/, 'r.status');
 
@@ -305,6 +319,13 @@ like(http_get('/send_buffer'), qr/send_buffer/, 'r.send accepts buffer');
 
 }
 
+like(http_get('/send_json?n=1'),
+	qr/\x0d\x0a\x0d\x0a\{"n":1,"a":\[\{"k":"value","s":"x\\"y"\}\]\}$/s,
+	'r.sendJSON small');
+like(http_get('/send_json?n=5000'),
+	qr/\x0d\x0a\x0d\x0a\{"n":5000,"a":\[(\{"k":"value","s":"x\\"y"\},){4999}
+	\{"k":"value","s":"x\\"y"\}\]\}$/sx, 'r.sendJSON');
+
 like(http_get('/return_method?c=200'), qr/200 OK.*\x0d\x0a?\x0d\x0a?$/s,
 	'return code');
 like(http_get('/return_method?c=200&t=SEE-THIS'), qr/200 OK.*^SEE-THIS$/ms,
@@ -61,6 +61,11 @@ http {
             js_content fun;
         }
 
+        location /test_lib2 {
+            js_import lib.js;
+            js_content lib.test;
+        }
+
         location /test_var {
             return 200 $test;
         }
@@ -114,12 +119,13 @@ $t->write_file('main.js', <<EOF);
 
 EOF
 
-$t->try_run('no njs available')->plan(5);
+$t->try_run('no njs available')->plan(6);
 
 ###############################################################################
 
 like(http_get('/test_foo'), qr/MAIN-TEST/s, 'foo.test');
 like(http_get('/test_lib'), qr/LIB-TEST/s, 'lib.test');
+like(http_get('/test_lib2'), qr/LIB-TEST/s, 'lib.test same imports');
 like(http_get('/test_fun'), qr/FUN-TEST/s, 'fun');
 like(http_get('/proxy/test_fun'), qr/FUN-TEST/s, 'proxy fun');
 like(http_get('/test_var'), qr/P-TEST/s, 'foo.bar.p');
@@ -0,0 +1,100 @@
+#!/usr/bin/perl
+
+# (C) Dmitry Volyntsev
+# (C) Nginx, Inc.
+
+# Tests for http njs module, js_memory_limit directive.
+
+###############################################################################
+
+use warnings;
+use strict;
+
+use Test::More;
+
+BEGIN { use FindBin; chdir($FindBin::Bin); }
+
+use lib 'lib';
+use Test::Nginx;
+
+###############################################################################
+
+select STDERR; $| = 1;
+select STDOUT; $| = 1;
+
+my $t = Test::Nginx->new()->has(qw/http/)
+	->write_file_expand('nginx.conf', <<'EOF');
+
+%%TEST_GLOBALS%%
+
+daemon off;
+
+events {
+}
+
+http {
+    %%TEST_GLOBALS_HTTP%%
+
+    js_import test.js;
+
+    server {
+        listen       127.0.0.1:8080;
+        server_name  localhost;
+
+        location /limited {
+            js_memory_limit 1m;
+            js_content test.alloc;
+        }
+
+        location /unlimited {
+            js_content test.alloc;
+        }
+
+        location /uncaught {
+            js_memory_limit 1m;
+            js_content test.uncaught;
+        }
+    }
+}
+
+EOF
+
+$t->write_file('test.js', <<EOF);
+    function alloc(r) {
+        var a = [];
+
+        try {
+            while (a.length < 1024) {
+                a.push('x'.repeat(4096));
+            }
+
+        } catch (e) {
+            r.return(200, `\${e}:\${a.length < 1024}`);
+            return;
+        }
+
+        r.return(200, `ok:\${a.length}`);
+    }
+
+    function uncaught(r) {
+        var a = [];
+
+        for (;;) {
+            a.push('x'.repeat(4096));
+        }
+    }
+
+    export default {alloc, uncaught};
+
+EOF
+
+$t->try_run('no js_memory_limit')->plan(4);
+
+###############################################################################
+
+like(http_get('/limited'), qr/MemoryError:true/, 'limited');
+like(http_get('/unlimited'), qr/ok:1024/, 'unlimited');
+like(http_get('/uncaught'), qr/500 Internal/, 'uncaught');
+like(http_get('/limited'), qr/MemoryError:true/, 'limited again');
+
+###############################################################################
@@ -0,0 +1,99 @@
+#!/usr/bin/perl
+
+# (C) Dmitry Volyntsev
+# (C) Nginx, Inc.
+
+# Tests for http njs module, js_vm_pool_size directive.
+
+###############################################################################
+
+use warnings;
+use strict;
+
+use Test::More;
+
+BEGIN { use FindBin; chdir($FindBin::Bin); }
+
+use lib 'lib';
+use Test::Nginx;
+
+###############################################################################
+
+select STDERR; $| = 1;
+select STDOUT; $| = 1;
+
+my $t = Test::Nginx->new()->has(qw/http/)
+	->write_file_expand('nginx.conf', <<'EOF');
+
+%%TEST_GLOBALS%%
+
+daemon off;
+
+events {
+}
+
+http {
+    %%TEST_GLOBALS_HTTP%%
+
+    js_import test.js;
+
+    js_vm_pool_size 2;
+
+    server {
+        listen       127.0.0.1:8080;
+        server_name  localhost;
+
+        location /count {
+            js_content test.count;
+        }
+
+        location /set {
+            js_set $test test.get;
+            return 200 set:$test;
+        }
+
+        location /own {
+            js_vm_pool_size 1;
+            js_content test.count;
+        }
+
+        location /limit {
+            js_memory_limit 1m;
+            js_content test.count;
+        }
+    }
+}
+
+EOF
+
+$t->write_file('test.js', <<EOF);
+    var n = 0;
+
+    function get(r) {
+        globalThis.g = (globalThis.g || 0) + 1;
+        n++;
+
+        return `\${n}:\${g}:\${r.uri}`;
+    }
+
+    function count(r) {
+        r.return(200, get(r));
+    }
+
+    export default {count, get};
+
+EOF
+
+$t->try_run('no js_vm_pool_size')->plan(7);
+
+###############################################################################
+
+like(http_get('/count'), qr/1:1:\/count/, 'first request');
+like(http_get('/count'), qr/1:1:\/count/, 'pooled vm is reset');
+like(http_get('/set'), qr/set:1:1:\/set/, 'js_set');
+like(http_get('/count'), qr/1:1:\/count/, 'pooled vm is reset again');
+like(http_get('/own'), qr/1:1:\/own/, 'own pool size');
+like(http_get('/own'), qr/1:1:\/own/, 'own pool size reset');
+like(http_get('/limit'), qr/1:1:\/limit/, 'pooled vm with memory limit');
+
+###############################################################################
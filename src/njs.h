@@ -240,6 +240,10 @@ typedef struct {
 
     njs_uint_t                      max_stack_size;
 
+    /* Memory limits of the VM memory pool, see njs_mp_limit(). */
+    size_t                          memory_limit;
+    size_t                          memory_soft_limit;
+
 /*
  * interactive  - enables "interactive" mode.
  *  (REPL). Allows starting parent VM without cloning.
@@ -289,6 +293,10 @@ typedef njs_int_t (*njs_iterator_handler_t)(njs_vm_t *vm,
     njs_value_t *retval);
 
 
+typedef njs_int_t (*njs_json_writer_t)(njs_vm_t *vm, const u_char *start,
+    size_t size, void *data);
+
+
 NJS_EXPORT void njs_vm_opt_init(njs_vm_opt_t *options);
 NJS_EXPORT njs_vm_t *njs_vm_create(njs_vm_opt_t *options);
 NJS_EXPORT void njs_vm_destroy(njs_vm_t *vm);
@@ -301,6 +309,13 @@ NJS_EXPORT njs_mod_t *njs_vm_add_module(njs_vm_t *vm, njs_str_t *name,
 NJS_EXPORT njs_mod_t *njs_vm_compile_module(njs_vm_t *vm, njs_str_t *name,
     u_char **start, u_char *end);
 NJS_EXPORT njs_vm_t *njs_vm_clone(njs_vm_t *vm, njs_external_ptr_t external);
+/*
+ * Reinitializes a finished clone of the VM as a fresh clone, reusing
+ * the memory pool of the former.  The former clone must not be used
+ * afterwards.  On failure the clone is destroyed and NULL is returned.
+ */
+NJS_EXPORT njs_vm_t *njs_vm_recycle(njs_vm_t *vm, njs_vm_t *clone,
+    njs_external_ptr_t external);
 
 NJS_EXPORT njs_int_t njs_vm_enqueue_job(njs_vm_t *vm, njs_function_t *function,
     const njs_value_t *args, njs_uint_t nargs);
@@ -394,6 +409,8 @@ NJS_EXPORT void njs_vm_error3(njs_vm_t *vm, unsigned type, const char *fmt,
 NJS_EXPORT void njs_vm_exception_get(njs_vm_t *vm, njs_value_t *retval);
 NJS_EXPORT njs_mp_t *njs_vm_memory_pool(njs_vm_t *vm);
 NJS_EXPORT njs_external_ptr_t njs_vm_external_ptr(njs_vm_t *vm);
+NJS_EXPORT void njs_vm_external_ptr_set(njs_vm_t *vm,
+    njs_external_ptr_t external);
 
 NJS_EXPORT njs_int_t njs_value_to_integer(njs_vm_t *vm, njs_value_t *value,
     int64_t *dst);
@@ -402,6 +419,19 @@ NJS_EXPORT njs_int_t njs_value_to_integer(njs_vm_t *vm, njs_value_t *value,
 NJS_EXPORT void njs_value_string_get(njs_value_t *value, njs_str_t *dst);
 NJS_EXPORT njs_int_t njs_vm_value_string_create(njs_vm_t *vm,
     njs_value_t *value, const u_char *start, uint32_t size);
+/*
+ *  Creates string value which shares its data with the equal strings
+ *  created before.  The strings are kept until the VM is destroyed,
+ *  so it is intended for a limited set of repeated names.
+ */
+NJS_EXPORT njs_int_t njs_vm_value_string_intern(njs_vm_t *vm,
+    njs_value_t *value, const u_char *start, uint32_t size);
+/*
+ *  Creates string value, no copy.  The data must outlive the VM
+ *  and must not be changed while the VM exists.
+ */
+NJS_EXPORT njs_int_t njs_vm_value_string_external(njs_vm_t *vm,
+    njs_value_t *value, const u_char *start, uint32_t size);
 NJS_EXPORT njs_int_t njs_vm_value_string_create_chb(njs_vm_t *vm,
     njs_value_t *value, njs_chb_t *chain);
 NJS_EXPORT njs_int_t njs_vm_string_compare(const njs_value_t *v1,
@@ -524,6 +554,12 @@ NJS_EXPORT njs_int_t njs_vm_json_parse(njs_vm_t *vm, njs_value_t *args,
     njs_uint_t nargs, njs_value_t *retval);
 NJS_EXPORT njs_int_t njs_vm_json_stringify(njs_vm_t *vm, njs_value_t *args,
     njs_uint_t nargs, njs_value_t *retval);
+/*
+ * Serializes args[0] like JSON.stringify(args[0], args[1], args[2]),
+ * passing the output to the writer in chunks as it is produced.
+ */
+NJS_EXPORT njs_int_t njs_vm_json_stringify_to(njs_vm_t *vm, njs_value_t *args,
+    njs_uint_t nargs, njs_json_writer_t writer, void *data);
 
 NJS_EXPORT njs_int_t njs_vm_query_string_parse(njs_vm_t *vm, u_char *start,
     u_char *end, njs_value_t *retval);
@@ -402,7 +402,7 @@ njs_builtin_traverse(njs_vm_t *vm, njs_traverse_t *traverse, void *data)
 
     ret = njs_lvlhsh_insert(&ctx->keys, &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert/replace failed");
+        njs_memory_error(vm);
         return NJS_ERROR;
     }
 
@@ -810,7 +810,7 @@ njs_global_this_object(njs_vm_t *vm, njs_object_prop_t *self,
 
     ret = njs_lvlhsh_insert(njs_object_hash(global), &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert/replace failed");
+        njs_memory_error(vm);
         return NJS_ERROR;
     }
 
@@ -860,7 +860,7 @@ njs_top_level_object(njs_vm_t *vm, njs_object_prop_t *self,
 
     ret = njs_lvlhsh_insert(njs_object_hash(global), &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert/replace failed");
+        njs_memory_error(vm);
         return NJS_ERROR;
     }
 
@@ -907,7 +907,7 @@ njs_top_level_constructor(njs_vm_t *vm, njs_object_prop_t *self,
 
     ret = njs_lvlhsh_insert(njs_object_hash(global), &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert/replace failed");
+        njs_memory_error(vm);
         return NJS_ERROR;
     }
 
@@ -1227,7 +1227,7 @@ njs_process_object_argv(njs_vm_t *vm, njs_object_prop_t *pr,
         return NJS_OK;
     }
 
-    njs_internal_error(vm, "lvlhsh insert failed");
+    njs_hash_insert_error(vm, ret);
 
     return NJS_ERROR;
 }
@@ -1298,7 +1298,7 @@ njs_env_hash_init(njs_vm_t *vm, njs_lvlhsh_t *hash, char **environment)
         ret = njs_lvlhsh_insert(hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
             if (ret == NJS_ERROR) {
-                njs_internal_error(vm, "lvlhsh insert failed");
+                njs_memory_error(vm);
                 return NJS_ERROR;
             }
 
@@ -1354,7 +1354,7 @@ njs_process_object_env(njs_vm_t *vm, njs_object_prop_t *pr,
         return NJS_OK;
     }
 
-    njs_internal_error(vm, "lvlhsh insert failed");
+    njs_hash_insert_error(vm, ret);
 
     return NJS_ERROR;
 }
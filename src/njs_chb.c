@@ -9,6 +9,7 @@
 
 
 #define NJS_CHB_MIN_SIZE       256
+#define NJS_CHB_MAX_SIZE       16384
 
 
 void
@@ -45,6 +46,7 @@ njs_chb_append0(njs_chb_t *chain, const char *msg, size_t len)
 u_char *
 njs_chb_reserve(njs_chb_t *chain, size_t size)
 {
+    size_t          min;
     njs_chb_node_t  *n;
 
     n = chain->last;
@@ -53,8 +55,17 @@ njs_chb_reserve(njs_chb_t *chain, size_t size)
         return n->pos;
     }
 
-    if (size < NJS_CHB_MIN_SIZE) {
-        size = NJS_CHB_MIN_SIZE;
+    /*
+     * Each node is twice as large as the previous one, so the number
+     * of nodes grows logarithmically with the size of the content.
+     */
+
+    min = (n != NULL) ? njs_min((size_t) (n->end - n->start) * 2,
+                                NJS_CHB_MAX_SIZE)
+                      : NJS_CHB_MIN_SIZE;
+
+    if (size < min) {
+        size = min;
     }
 
     n = chain->alloc(chain->pool, sizeof(njs_chb_node_t) + size);
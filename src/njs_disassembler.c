@@ -10,156 +10,104 @@
 
 typedef struct {
     njs_vmcode_t               operation;
-    size_t                     size;
     njs_str_t                  name;
 } njs_code_name_t;
 
 
 static njs_code_name_t  code_names[] = {
 
-    { NJS_VMCODE_PUT_ARG, sizeof(njs_vmcode_1addr_t),
-          njs_str("PUT ARG         ") },
-    { NJS_VMCODE_OBJECT, sizeof(njs_vmcode_object_t),
-          njs_str("OBJECT          ") },
-    { NJS_VMCODE_FUNCTION, sizeof(njs_vmcode_function_t),
-          njs_str("FUNCTION        ") },
-    { NJS_VMCODE_ARGUMENTS, sizeof(njs_vmcode_arguments_t),
-          njs_str("ARGUMENTS       ") },
-    { NJS_VMCODE_REGEXP, sizeof(njs_vmcode_regexp_t),
-          njs_str("REGEXP          ") },
-    { NJS_VMCODE_TEMPLATE_LITERAL, sizeof(njs_vmcode_template_literal_t),
-          njs_str("TEMPLATE LITERAL") },
-
-    { NJS_VMCODE_FUNCTION_COPY, sizeof(njs_vmcode_function_copy_t),
-          njs_str("FUNCTION COPY   ") },
-
-    { NJS_VMCODE_PROPERTY_GET, sizeof(njs_vmcode_prop_get_t),
-          njs_str("PROP GET        ") },
-    { NJS_VMCODE_GLOBAL_GET, sizeof(njs_vmcode_prop_get_t),
-          njs_str("GLOBAL GET      ") },
-    { NJS_VMCODE_PROPERTY_INIT, sizeof(njs_vmcode_prop_set_t),
-          njs_str("PROP INIT       ") },
-    { NJS_VMCODE_PROTO_INIT, sizeof(njs_vmcode_prop_set_t),
-          njs_str("PROTO INIT      ") },
-    { NJS_VMCODE_PROPERTY_SET, sizeof(njs_vmcode_prop_set_t),
-          njs_str("PROP SET        ") },
-    { NJS_VMCODE_PROPERTY_IN, sizeof(njs_vmcode_3addr_t),
-          njs_str("PROP IN         ") },
-    { NJS_VMCODE_PROPERTY_DELETE, sizeof(njs_vmcode_3addr_t),
-          njs_str("PROP DELETE     ") },
-    { NJS_VMCODE_INSTANCE_OF, sizeof(njs_vmcode_instance_of_t),
-          njs_str("INSTANCE OF     ") },
-
-    { NJS_VMCODE_FUNCTION_CALL, sizeof(njs_vmcode_function_call_t),
-          njs_str("FUNCTION CALL   ") },
-    { NJS_VMCODE_RETURN, sizeof(njs_vmcode_return_t),
-          njs_str("RETURN          ") },
-    { NJS_VMCODE_STOP, sizeof(njs_vmcode_stop_t),
-          njs_str("STOP            ") },
-
-    { NJS_VMCODE_INCREMENT, sizeof(njs_vmcode_3addr_t),
-          njs_str("INC             ") },
-    { NJS_VMCODE_DECREMENT, sizeof(njs_vmcode_3addr_t),
-          njs_str("DEC             ") },
-    { NJS_VMCODE_POST_INCREMENT, sizeof(njs_vmcode_3addr_t),
-          njs_str("POST INC        ") },
-    { NJS_VMCODE_POST_DECREMENT, sizeof(njs_vmcode_3addr_t),
-          njs_str("POST DEC        ") },
-
-    { NJS_VMCODE_DELETE, sizeof(njs_vmcode_2addr_t),
-          njs_str("DELETE          ") },
-    { NJS_VMCODE_VOID, sizeof(njs_vmcode_2addr_t),
-          njs_str("VOID            ") },
-    { NJS_VMCODE_TYPEOF, sizeof(njs_vmcode_2addr_t),
-          njs_str("TYPEOF          ") },
-    { NJS_VMCODE_TO_PROPERTY_KEY, sizeof(njs_vmcode_2addr_t),
-          njs_str("TO PROP KEY     ") },
-    { NJS_VMCODE_TO_PROPERTY_KEY_CHK, sizeof(njs_vmcode_3addr_t),
-          njs_str("TO PROP KEY CHK ") },
-    { NJS_VMCODE_SET_FUNCTION_NAME, sizeof(njs_vmcode_2addr_t),
-          njs_str("SET FUNC NAME   ") },
-
-    { NJS_VMCODE_UNARY_PLUS, sizeof(njs_vmcode_2addr_t),
-          njs_str("PLUS            ") },
-    { NJS_VMCODE_UNARY_NEGATION, sizeof(njs_vmcode_2addr_t),
-          njs_str("NEGATION        ") },
-
-    { NJS_VMCODE_ADDITION, sizeof(njs_vmcode_3addr_t),
-          njs_str("ADD             ") },
-    { NJS_VMCODE_SUBTRACTION, sizeof(njs_vmcode_3addr_t),
-          njs_str("SUBTRACT        ") },
-    { NJS_VMCODE_MULTIPLICATION, sizeof(njs_vmcode_3addr_t),
-          njs_str("MULTIPLY        ") },
-    { NJS_VMCODE_EXPONENTIATION, sizeof(njs_vmcode_3addr_t),
-          njs_str("POWER           ") },
-    { NJS_VMCODE_DIVISION, sizeof(njs_vmcode_3addr_t),
-          njs_str("DIVIDE          ") },
-    { NJS_VMCODE_REMAINDER, sizeof(njs_vmcode_3addr_t),
-          njs_str("REMAINDER       ") },
-
-    { NJS_VMCODE_LEFT_SHIFT, sizeof(njs_vmcode_3addr_t),
-          njs_str("LEFT SHIFT      ") },
-    { NJS_VMCODE_RIGHT_SHIFT, sizeof(njs_vmcode_3addr_t),
-          njs_str("RIGHT SHIFT     ") },
-    { NJS_VMCODE_UNSIGNED_RIGHT_SHIFT, sizeof(njs_vmcode_3addr_t),
-          njs_str("USGN RIGHT SHIFT") },
-
-    { NJS_VMCODE_LOGICAL_NOT, sizeof(njs_vmcode_2addr_t),
-          njs_str("LOGICAL NOT     ") },
-
-    { NJS_VMCODE_BITWISE_NOT, sizeof(njs_vmcode_2addr_t),
-          njs_str("BINARY NOT      ") },
-    { NJS_VMCODE_BITWISE_AND, sizeof(njs_vmcode_3addr_t),
-          njs_str("BINARY AND      ") },
-    { NJS_VMCODE_BITWISE_XOR, sizeof(njs_vmcode_3addr_t),
-          njs_str("BINARY XOR      ") },
-    { NJS_VMCODE_BITWISE_OR, sizeof(njs_vmcode_3addr_t),
-          njs_str("BINARY OR       ") },
-
-    { NJS_VMCODE_EQUAL, sizeof(njs_vmcode_3addr_t),
-          njs_str("EQUAL           ") },
-    { NJS_VMCODE_NOT_EQUAL, sizeof(njs_vmcode_3addr_t),
-          njs_str("NOT EQUAL       ") },
-    { NJS_VMCODE_LESS, sizeof(njs_vmcode_3addr_t),
-          njs_str("LESS            ") },
-    { NJS_VMCODE_LESS_OR_EQUAL, sizeof(njs_vmcode_3addr_t),
-          njs_str("LESS OR EQUAL   ") },
-    { NJS_VMCODE_GREATER, sizeof(njs_vmcode_3addr_t),
-          njs_str("GREATER         ") },
-    { NJS_VMCODE_GREATER_OR_EQUAL, sizeof(njs_vmcode_3addr_t),
-          njs_str("GREATER OR EQUAL") },
-
-    { NJS_VMCODE_STRICT_EQUAL, sizeof(njs_vmcode_3addr_t),
-          njs_str("STRICT EQUAL    ") },
-    { NJS_VMCODE_STRICT_NOT_EQUAL, sizeof(njs_vmcode_3addr_t),
-          njs_str("STRICT NOT EQUAL") },
-
-    { NJS_VMCODE_MOVE, sizeof(njs_vmcode_move_t),
-          njs_str("MOVE            ") },
-
-    { NJS_VMCODE_THROW, sizeof(njs_vmcode_throw_t),
-          njs_str("THROW           ") },
-
-    { NJS_VMCODE_LET, sizeof(njs_vmcode_variable_t),
-          njs_str("LET             ") },
-
-    { NJS_VMCODE_LET_UPDATE, sizeof(njs_vmcode_variable_t),
-          njs_str("LET UPDATE      ") },
-
-    { NJS_VMCODE_INITIALIZATION_TEST, sizeof(njs_vmcode_variable_t),
-          njs_str("INIT TEST       ") },
-
-    { NJS_VMCODE_NOT_INITIALIZED, sizeof(njs_vmcode_variable_t),
-          njs_str("NOT INIT        ") },
-
-    { NJS_VMCODE_ASSIGNMENT_ERROR, sizeof(njs_vmcode_variable_t),
-          njs_str("ASSIGNMENT ERROR") },
-
-    { NJS_VMCODE_DEBUGGER, sizeof(njs_vmcode_debugger_t),
-          njs_str("DEBUGGER        ") },
-
-    { NJS_VMCODE_AWAIT, sizeof(njs_vmcode_await_t),
-          njs_str("AWAIT           ") },
+    { NJS_VMCODE_PUT_ARG, njs_str("PUT ARG         ") },
+    { NJS_VMCODE_OBJECT, njs_str("OBJECT          ") },
+    { NJS_VMCODE_FUNCTION, njs_str("FUNCTION        ") },
+    { NJS_VMCODE_ARGUMENTS, njs_str("ARGUMENTS       ") },
+    { NJS_VMCODE_REGEXP, njs_str("REGEXP          ") },
+    { NJS_VMCODE_TEMPLATE_LITERAL, njs_str("TEMPLATE LITERAL") },
+
+    { NJS_VMCODE_FUNCTION_COPY, njs_str("FUNCTION COPY   ") },
+
+    { NJS_VMCODE_PROPERTY_GET, njs_str("PROP GET        ") },
+    { NJS_VMCODE_GLOBAL_GET, njs_str("GLOBAL GET      ") },
+    { NJS_VMCODE_PROPERTY_INIT, njs_str("PROP INIT       ") },
+    { NJS_VMCODE_PROTO_INIT, njs_str("PROTO INIT      ") },
+    { NJS_VMCODE_PROPERTY_SET, njs_str("PROP SET        ") },
+    { NJS_VMCODE_PROPERTY_IN, njs_str("PROP IN         ") },
+    { NJS_VMCODE_PROPERTY_DELETE, njs_str("PROP DELETE     ") },
+    { NJS_VMCODE_INSTANCE_OF, njs_str("INSTANCE OF     ") },
+
+    { NJS_VMCODE_FUNCTION_CALL, njs_str("FUNCTION CALL   ") },
+    { NJS_VMCODE_RETURN, njs_str("RETURN          ") },
+    { NJS_VMCODE_STOP, njs_str("STOP            ") },
+
+    { NJS_VMCODE_INCREMENT, njs_str("INC             ") },
+    { NJS_VMCODE_DECREMENT, njs_str("DEC             ") },
+    { NJS_VMCODE_POST_INCREMENT, njs_str("POST INC        ") },
+    { NJS_VMCODE_POST_DECREMENT, njs_str("POST DEC        ") },
+
+    { NJS_VMCODE_DELETE, njs_str("DELETE          ") },
+    { NJS_VMCODE_VOID, njs_str("VOID            ") },
+    { NJS_VMCODE_TYPEOF, njs_str("TYPEOF          ") },
+    { NJS_VMCODE_TO_PROPERTY_KEY, njs_str("TO PROP KEY     ") },
+    { NJS_VMCODE_TO_PROPERTY_KEY_CHK, njs_str("TO PROP KEY CHK ") },
+    { NJS_VMCODE_SET_FUNCTION_NAME, njs_str("SET FUNC NAME   ") },
+
+    { NJS_VMCODE_UNARY_PLUS, njs_str("PLUS            ") },
+    { NJS_VMCODE_UNARY_NEGATION, njs_str("NEGATION        ") },
+
+    { NJS_VMCODE_ADDITION, njs_str("ADD             ") },
+    { NJS_VMCODE_SUBTRACTION, njs_str("SUBTRACT        ") },
+    { NJS_VMCODE_MULTIPLICATION, njs_str("MULTIPLY        ") },
+    { NJS_VMCODE_EXPONENTIATION, njs_str("POWER           ") },
+    { NJS_VMCODE_DIVISION, njs_str("DIVIDE          ") },
+    { NJS_VMCODE_REMAINDER, njs_str("REMAINDER       ") },
+
+    { NJS_VMCODE_LEFT_SHIFT, njs_str("LEFT SHIFT      ") },
+    { NJS_VMCODE_RIGHT_SHIFT, njs_str("RIGHT SHIFT     ") },
+    { NJS_VMCODE_UNSIGNED_RIGHT_SHIFT, njs_str("USGN RIGHT SHIFT") },
+
+    { NJS_VMCODE_LOGICAL_NOT, njs_str("LOGICAL NOT     ") },
+
+    { NJS_VMCODE_BITWISE_NOT, njs_str("BINARY NOT      ") },
+    { NJS_VMCODE_BITWISE_AND, njs_str("BINARY AND      ") },
+    { NJS_VMCODE_BITWISE_XOR, njs_str("BINARY XOR      ") },
+    { NJS_VMCODE_BITWISE_OR, njs_str("BINARY OR       ") },
+
+    { NJS_VMCODE_EQUAL, njs_str("EQUAL           ") },
+    { NJS_VMCODE_NOT_EQUAL, njs_str("NOT EQUAL       ") },
+    { NJS_VMCODE_LESS, njs_str("LESS            ") },
+    { NJS_VMCODE_LESS_OR_EQUAL, njs_str("LESS OR EQUAL   ") },
+    { NJS_VMCODE_GREATER, njs_str("GREATER         ") },
+    { NJS_VMCODE_GREATER_OR_EQUAL, njs_str("GREATER OR EQUAL") },
+
+    { NJS_VMCODE_ADDITION_NUMBER, njs_str("ADD NUMBER      ") },
+    { NJS_VMCODE_LESS_NUMBER, njs_str("LESS NUMBER     ") },
+    { NJS_VMCODE_GREATER_NUMBER, njs_str("GREATER NUMBER  ") },
+    { NJS_VMCODE_LESS_OR_EQUAL_NUMBER, njs_str("LESS EQ NUMBER  ") },
+    { NJS_VMCODE_GREATER_OR_EQUAL_NUMBER, njs_str("GREATER EQ NUMB ") },
+    { NJS_VMCODE_LESS_JUMP, njs_str("LESS JUMP       ") },
+    { NJS_VMCODE_GREATER_JUMP, njs_str("GREATER JUMP    ") },
+    { NJS_VMCODE_LESS_OR_EQUAL_JUMP, njs_str("LESS EQ JUMP    ") },
+    { NJS_VMCODE_GREATER_OR_EQUAL_JUMP, njs_str("GREATER EQ JUMP ") },
+
+    { NJS_VMCODE_STRICT_EQUAL, njs_str("STRICT EQUAL    ") },
+    { NJS_VMCODE_STRICT_NOT_EQUAL, njs_str("STRICT NOT EQUAL") },
+
+    { NJS_VMCODE_MOVE, njs_str("MOVE            ") },
+
+    { NJS_VMCODE_THROW, njs_str("THROW           ") },
+
+    { NJS_VMCODE_LET, njs_str("LET             ") },
+
+    { NJS_VMCODE_LET_UPDATE, njs_str("LET UPDATE      ") },
+
+    { NJS_VMCODE_INITIALIZATION_TEST, njs_str("INIT TEST       ") },
+
+    { NJS_VMCODE_NOT_INITIALIZED, njs_str("NOT INIT        ") },
+
+    { NJS_VMCODE_ASSIGNMENT_ERROR, njs_str("ASSIGNMENT ERROR") },
+
+    { NJS_VMCODE_DEBUGGER, njs_str("DEBUGGER        ") },
+
+    { NJS_VMCODE_AWAIT, njs_str("AWAIT           ") },
 };
 
 
@@ -187,6 +135,7 @@ void
 njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
 {
     u_char                       *p;
+    size_t                       size;
     uint32_t                     line;
     njs_str_t                    *name;
     njs_uint_t                   n;
@@ -234,7 +183,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) array->retval,
                        (size_t) array->length, array->ctor ? " INIT" : "");
 
-            p += sizeof(njs_vmcode_array_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -246,7 +195,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) cond_jump->cond,
                        (size_t) cond_jump->offset);
 
-            p += sizeof(njs_vmcode_cond_jump_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -258,7 +207,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) cond_jump->cond,
                        (size_t) cond_jump->offset);
 
-            p += sizeof(njs_vmcode_cond_jump_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -269,7 +218,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
             njs_printf("%5uD | %05uz JUMP              %z\n",
                        line, p - start, (size_t) jump->offset);
 
-            p += sizeof(njs_vmcode_jump_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -281,7 +230,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) equal->value1,
                        (size_t) equal->value2, (size_t) equal->offset);
 
-            p += sizeof(njs_vmcode_equal_jump_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -293,7 +242,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) test_jump->retval,
                        (size_t) test_jump->value, (size_t) test_jump->offset);
 
-            p += sizeof(njs_vmcode_test_jump_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -305,7 +254,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) test_jump->retval,
                        (size_t) test_jump->value, (size_t) test_jump->offset);
 
-            p += sizeof(njs_vmcode_test_jump_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -317,7 +266,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) test_jump->retval,
                        (size_t) test_jump->value, (size_t) test_jump->offset);
 
-            p += sizeof(njs_vmcode_test_jump_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -329,7 +278,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) function->name,
                        function->nargs, function->ctor ? " CTOR" : "");
 
-            p += sizeof(njs_vmcode_function_frame_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -342,7 +291,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        (size_t) method->method, method->nargs,
                        method->ctor ? " CTOR" : "");
 
-            p += sizeof(njs_vmcode_method_frame_t);
+            p += njs_vmcode_size[operation];
             continue;
         }
 
@@ -354,7 +303,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        (size_t) prop_foreach->object,
                        (size_t) prop_foreach->offset);
 
-            p += sizeof(njs_vmcode_prop_foreach_t);
+            p += njs_vmcode_size[operation];
             continue;
         }
 
@@ -366,7 +315,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        (size_t) prop_next->object, (size_t) prop_next->next,
                        (size_t) prop_next->offset);
 
-            p += sizeof(njs_vmcode_prop_next_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -382,7 +331,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        (size_t) prop_accessor->object,
                        (size_t) prop_accessor->property);
 
-            p += sizeof(njs_vmcode_prop_accessor_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -394,7 +343,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) import->retval,
                        &import->module->name);
 
-            p += sizeof(njs_vmcode_import_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -407,7 +356,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        (size_t) try_start->exit_value,
                        (size_t) try_start->offset);
 
-            p += sizeof(njs_vmcode_try_start_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -419,7 +368,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) try_tramp->exit_value,
                        (size_t) try_tramp->offset);
 
-            p += sizeof(njs_vmcode_try_trampoline_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -431,7 +380,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) try_tramp->exit_value,
                        (size_t) try_tramp->offset);
 
-            p += sizeof(njs_vmcode_try_trampoline_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -444,7 +393,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        (size_t) try_return->retval,
                        (size_t) try_return->offset);
 
-            p += sizeof(njs_vmcode_try_return_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -456,7 +405,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        line, p - start, (size_t) catch->exception,
                        (size_t) catch->offset);
 
-            p += sizeof(njs_vmcode_catch_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -467,7 +416,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
             njs_printf("%5uD | %05uz TRY END           %z\n",
                        line, p - start, (size_t) try_end->offset);
 
-            p += sizeof(njs_vmcode_try_end_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -481,7 +430,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                        (size_t) finally->continue_offset,
                        (size_t) finally->break_offset);
 
-            p += sizeof(njs_vmcode_finally_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -505,7 +454,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
 
             njs_printf("%5uD | %05uz %s ERROR\n", line, p - start, type);
 
-            p += sizeof(njs_vmcode_error_t);
+            p += njs_vmcode_size[operation];
 
             continue;
         }
@@ -516,8 +465,9 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
         do {
             if (operation == code_name->operation) {
                 name = &code_name->name;
+                size = njs_vmcode_size[operation];
 
-                if (code_name->size == sizeof(njs_vmcode_3addr_t)) {
+                if (size == sizeof(njs_vmcode_3addr_t)) {
                     code3 = (njs_vmcode_3addr_t *) p;
 
                     njs_printf("%5uD | %05uz %*s  %04Xz %04Xz %04Xz\n",
@@ -525,14 +475,14 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                                (size_t) code3->dst, (size_t) code3->src1,
                                (size_t) code3->src2);
 
-                } else if (code_name->size == sizeof(njs_vmcode_2addr_t)) {
+                } else if (size == sizeof(njs_vmcode_2addr_t)) {
                     code2 = (njs_vmcode_2addr_t *) p;
 
                     njs_printf("%5uD | %05uz %*s  %04Xz %04Xz\n",
                                line, p - start, name->length, name->start,
                                (size_t) code2->dst, (size_t) code2->src);
 
-                } else if (code_name->size == sizeof(njs_vmcode_1addr_t)) {
+                } else if (size == sizeof(njs_vmcode_1addr_t)) {
                     code1 = (njs_vmcode_1addr_t *) p;
 
                     njs_printf("%5uD | %05uz %*s  %04Xz\n",
@@ -540,7 +490,7 @@ njs_disassemble(u_char *start, u_char *end, njs_int_t count, njs_arr_t *lines)
                                (size_t) code1->index);
                 }
 
-                p += code_name->size;
+                p += size;
 
                 goto next;
             }
@@ -229,7 +229,7 @@ njs_error_alloc(njs_vm_t *vm, njs_object_t *proto, const njs_value_t *name,
 
         ret = njs_lvlhsh_insert(&error->hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             return NULL;
         }
     }
@@ -249,7 +249,7 @@ njs_error_alloc(njs_vm_t *vm, njs_object_t *proto, const njs_value_t *name,
 
         ret = njs_lvlhsh_insert(&error->hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             return NULL;
         }
     }
@@ -269,7 +269,7 @@ njs_error_alloc(njs_vm_t *vm, njs_object_t *proto, const njs_value_t *name,
 
         ret = njs_lvlhsh_insert(&error->hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             return NULL;
         }
     }
@@ -515,6 +515,23 @@ njs_memory_error(njs_vm_t *vm)
 }
 
 
+/*
+ * Hash insertion returns NJS_ERROR only if the memory allocation fails,
+ * NJS_DECLINED means that the key already exists.
+ */
+
+void
+njs_hash_insert_error(njs_vm_t *vm, njs_int_t ret)
+{
+    if (ret == NJS_ERROR) {
+        njs_memory_error(vm);
+        return;
+    }
+
+    njs_internal_error(vm, "lvlhsh insert failed");
+}
+
+
 static njs_int_t
 njs_memory_error_constructor(njs_vm_t *vm, njs_value_t *args,
     njs_uint_t nargs, njs_index_t unused, njs_value_t *retval)
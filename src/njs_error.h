@@ -35,6 +35,7 @@ void njs_throw_error_va(njs_vm_t *vm, njs_object_t *proto, const char *fmt,
     va_list args);
 
 void njs_memory_error(njs_vm_t *vm);
+void njs_hash_insert_error(njs_vm_t *vm, njs_int_t ret);
 void njs_memory_error_set(njs_vm_t *vm, njs_value_t *value);
 
 njs_object_t *njs_error_alloc(njs_vm_t *vm, njs_object_t *proto,
@@ -172,7 +172,7 @@ njs_external_add(njs_vm_t *vm, njs_arr_t *protos,
 
         ret = njs_lvlhsh_insert(hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             return NJS_ERROR;
         }
 
@@ -244,7 +244,7 @@ njs_external_prop_handler(njs_vm_t *vm, njs_object_prop_t *self,
 
     ret = njs_lvlhsh_insert(njs_object_hash(value), &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert/replace failed");
+        njs_memory_error(vm);
         return NJS_ERROR;
     }
 
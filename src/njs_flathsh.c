@@ -76,14 +76,6 @@
 #define NJS_FLATHSH_ELTS_MINIMUM_TO_SHRINK    8
 
 
-struct njs_flathsh_descr_s {
-    uint32_t     hash_mask;
-    uint32_t     elts_size;          /* allocated properties */
-    uint32_t     elts_count;         /* include deleted properties */
-    uint32_t     elts_deleted_count;
-};
-
-
 static njs_flathsh_descr_t *njs_flathsh_alloc(njs_flathsh_query_t *fhq,
     size_t hash_size, size_t elts_size);
 static njs_flathsh_descr_t *njs_expand_elts(njs_flathsh_query_t *fhq,
@@ -147,7 +139,7 @@ njs_flathsh_chunk(njs_flathsh_descr_t *h)
 njs_inline njs_flathsh_elt_t *
 njs_hash_elts(njs_flathsh_descr_t *h)
 {
-    return (njs_flathsh_elt_t *) ((char *) h + sizeof(njs_flathsh_descr_t));
+    return njs_flathsh_elts(h);
 }
 
 
@@ -162,6 +154,26 @@ njs_flathsh_new(njs_flathsh_query_t *fhq)
 }
 
 
+/*
+ * Create a new empty flat hash with room for elts_size elements.
+ */
+njs_flathsh_descr_t *
+njs_flathsh_new_size(njs_flathsh_query_t *fhq, uint32_t elts_size)
+{
+    size_t  hash_size;
+
+    elts_size = njs_max(elts_size, NJS_FLATHSH_ELTS_INITIAL_SIZE);
+
+    hash_size = NJS_FLATHSH_HASH_INITIAL_SIZE;
+
+    while (hash_size < elts_size) {
+        hash_size = 2 * hash_size;
+    }
+
+    return njs_flathsh_alloc(fhq, hash_size, elts_size);
+}
+
+
 void
 njs_flathsh_destroy(njs_flathsh_t *fh, njs_flathsh_query_t *fhq)
 {
@@ -359,6 +371,39 @@ njs_flathsh_find(const njs_flathsh_t *fh, njs_flathsh_query_t *fhq)
 }
 
 
+njs_flathsh_elt_t *
+njs_flathsh_find_elt(const njs_flathsh_t *fh, njs_flathsh_query_t *fhq)
+{
+    njs_int_t            cell_num, elt_num;
+    njs_flathsh_elt_t    *e, *elts;
+    njs_flathsh_descr_t  *h;
+
+    h = fh->slot;
+    if (njs_slow_path(h == NULL)) {
+        return NULL;
+    }
+
+    cell_num = fhq->key_hash & h->hash_mask;
+    elt_num = njs_hash_cells_end(h)[-cell_num - 1];
+    elts = njs_hash_elts(h);
+
+    while (elt_num != 0) {
+        e = &elts[elt_num - 1];
+
+        if (e->key_hash == fhq->key_hash &&
+            fhq->proto->test(fhq, e->value) == NJS_OK)
+        {
+            fhq->value = e->value;
+            return e;
+        }
+
+        elt_num = e->next_elt;
+    }
+
+    return NULL;
+}
+
+
 njs_int_t
 njs_flathsh_insert(njs_flathsh_t *fh, njs_flathsh_query_t *fhq)
 {
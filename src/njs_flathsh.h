@@ -19,9 +19,16 @@ typedef struct {
 } njs_flathsh_elt_t;
 
 
-typedef struct njs_flathsh_descr_s  njs_flathsh_descr_t;
 typedef struct njs_flathsh_query_s  njs_flathsh_query_t;
 
+
+typedef struct {
+    uint32_t     hash_mask;
+    uint32_t     elts_size;          /* allocated properties */
+    uint32_t     elts_count;         /* include deleted properties */
+    uint32_t     elts_deleted_count;
+} njs_flathsh_descr_t;
+
 typedef njs_int_t (*njs_flathsh_test_t)(njs_flathsh_query_t *fhq, void *data);
 typedef void *(*njs_flathsh_alloc_t)(void *ctx, size_t size);
 typedef void (*njs_flathsh_free_t)(void *ctx, void *p, size_t size);
@@ -64,6 +71,31 @@ struct njs_flathsh_query_s {
     ((fhl)->slot == (fhr)->slot)
 
 
+#define njs_flathsh_elts(h)                                                    \
+    ((njs_flathsh_elt_t *) ((char *) (h) + sizeof(njs_flathsh_descr_t)))
+
+
+/*
+ * njs_flathsh_elt() returns an element by its position in the insertion
+ * order or NULL if the position is out of range.  The position of an element
+ * is stable until the hash is expanded or shrunk, both operations replace
+ * the descriptor stored in fh->slot.
+ */
+njs_inline njs_flathsh_elt_t *
+njs_flathsh_elt(const njs_flathsh_t *fh, uint32_t index)
+{
+    njs_flathsh_descr_t  *h;
+
+    h = fh->slot;
+
+    if (h == NULL || index >= h->elts_count) {
+        return NULL;
+    }
+
+    return &njs_flathsh_elts(h)[index];
+}
+
+
 /*
  * njs_flathsh_find() finds a hash element.  If the element has been
  * found then it is stored in the fhq->value and njs_flathsh_find()
@@ -74,6 +106,13 @@ struct njs_flathsh_query_s {
 NJS_EXPORT njs_int_t njs_flathsh_find(const njs_flathsh_t *fh,
     njs_flathsh_query_t *fhq);
 
+/*
+ * njs_flathsh_find_elt() is similar to njs_flathsh_find(), but returns
+ * the found element or NULL.
+ */
+NJS_EXPORT njs_flathsh_elt_t *njs_flathsh_find_elt(const njs_flathsh_t *fh,
+    njs_flathsh_query_t *fhq);
+
 /*
  * njs_flathsh_insert() adds a hash element.  If the element is already
  * present in flathsh and the fhq->replace flag is zero, then fhq->value
@@ -130,6 +169,8 @@ NJS_EXPORT njs_flathsh_elt_t *njs_flathsh_add_elt(njs_flathsh_t *fh,
     njs_flathsh_query_t *fhq);
 
 NJS_EXPORT njs_flathsh_descr_t *njs_flathsh_new(njs_flathsh_query_t *fhq);
+NJS_EXPORT njs_flathsh_descr_t *njs_flathsh_new_size(njs_flathsh_query_t *fhq,
+    uint32_t elts_size);
 NJS_EXPORT void njs_flathsh_destroy(njs_flathsh_t *fh, njs_flathsh_query_t *fhq);
 
 
@@ -183,7 +183,7 @@ njs_function_name_set(njs_vm_t *vm, njs_function_t *function,
 
     ret = njs_lvlhsh_insert(&function->object.hash, &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert failed");
+        njs_hash_insert_error(vm, ret);
         return NJS_ERROR;
     }
 
@@ -934,7 +934,7 @@ njs_function_property_prototype_set(njs_vm_t *vm, njs_lvlhsh_t *hash,
         return njs_prop_value(prop);
     }
 
-    njs_internal_error(vm, "lvlhsh insert failed");
+    njs_hash_insert_error(vm, ret);
 
     return NULL;
 }
@@ -11,6 +11,7 @@
 
 
 #define NJS_FUNCTION_MAX_DEPTH  128
+#define NJS_SHAPE_MAX_PROPS     64
 
 
 typedef struct njs_generator_patch_s   njs_generator_patch_t;
@@ -155,6 +156,9 @@ static njs_int_t njs_generate_while_condition(njs_vm_t *vm,
     njs_generator_t *generator, njs_parser_node_t *node);
 static njs_int_t njs_generate_while_end(njs_vm_t *vm,
     njs_generator_t *generator, njs_parser_node_t *node);
+static njs_int_t njs_generate_loop_jump(njs_vm_t *vm,
+    njs_generator_t *generator, njs_generator_loop_ctx_t *ctx,
+    njs_parser_node_t *cond);
 static njs_int_t njs_generate_do_while_statement(njs_vm_t *vm,
     njs_generator_t *generator, njs_parser_node_t *node);
 static njs_int_t njs_generate_do_while_condition(njs_vm_t *vm,
@@ -256,6 +260,8 @@ static njs_int_t njs_generate_operation_assignment_end(njs_vm_t *vm,
     njs_generator_t *generator, njs_parser_node_t *node);
 static njs_int_t njs_generate_object(njs_vm_t *vm, njs_generator_t *generator,
     njs_parser_node_t *node);
+static njs_int_t njs_generate_object_shape(njs_vm_t *vm,
+    njs_parser_node_t *node, njs_object_shape_t **shape);
 static njs_int_t njs_generate_property_accessor(njs_vm_t *vm,
     njs_generator_t *generator, njs_parser_node_t *node);
 static njs_int_t njs_generate_property_accessor_end(njs_vm_t *vm,
@@ -303,6 +309,10 @@ static njs_int_t njs_generate_function_scope(njs_vm_t *vm,
     njs_parser_node_t *node, const njs_str_t *name);
 static njs_int_t njs_generate_scope_end(njs_vm_t *vm,
     njs_generator_t *generator, njs_parser_node_t *node);
+static void njs_generate_jumps_optimize(njs_vm_t *vm,
+    njs_generator_t *generator);
+static u_char *njs_generate_jump_target(njs_vm_t *vm, u_char *target,
+    njs_vmcode_t operation, njs_index_t cond);
 static int64_t njs_generate_lambda_variables(njs_vm_t *vm,
     njs_generator_t *generator, njs_parser_node_t *node);
 static njs_int_t njs_generate_return_statement(njs_vm_t *vm,
@@ -391,6 +401,7 @@ static njs_int_t njs_generate_index_release(njs_vm_t *vm,
                                                                               \
         generator->code_end += sizeof(type);                                  \
                                                                               \
+        njs_memzero(_code, sizeof(type));                                     \
         _code->code = _op;                                                    \
     } while (0)
 
@@ -474,6 +485,7 @@ njs_generator_init(njs_generator_t *generator, njs_str_t *file,
     njs_memzero(generator, sizeof(njs_generator_t));
 
     njs_queue_init(&generator->stack);
+    njs_queue_init(&generator->stack_free);
 
     generator->file = *file;
     generator->depth = depth;
@@ -497,11 +509,21 @@ njs_generator_after(njs_vm_t *vm, njs_generator_t *generator,
     njs_queue_link_t *link, njs_parser_node_t *node,
     njs_generator_state_func_t state, void *ctx, size_t size)
 {
+    njs_queue_link_t             *lnk;
     njs_generator_stack_entry_t  *entry;
 
-    entry = njs_mp_alloc(vm->mem_pool, sizeof(njs_generator_stack_entry_t));
-    if (njs_slow_path(entry == NULL)) {
-        return NJS_ERROR;
+    if (!njs_queue_is_empty(&generator->stack_free)) {
+        lnk = njs_queue_first(&generator->stack_free);
+        njs_queue_remove(lnk);
+
+        entry = njs_queue_link_data(lnk, njs_generator_stack_entry_t, link);
+
+    } else {
+        entry = njs_mp_alloc(vm->mem_pool,
+                             sizeof(njs_generator_stack_entry_t));
+        if (njs_slow_path(entry == NULL)) {
+            return NJS_ERROR;
+        }
     }
 
     entry->state = state;
@@ -543,12 +565,32 @@ njs_generator_stack_pop(njs_vm_t *vm, njs_generator_t *generator, void *ctx)
 
     njs_generator_next(generator, entry->state, entry->node);
 
-    njs_mp_free(vm->mem_pool, entry);
+    njs_queue_insert_head(&generator->stack_free, link);
 
     return NJS_OK;
 }
 
 
+/*
+ * The hash of a string literal property key is computed at compile time,
+ * zero means that the hash is computed at runtime.
+ */
+
+njs_inline uint32_t
+njs_generate_key_hash(njs_parser_node_t *node)
+{
+    njs_str_t  key;
+
+    if (node->token_type != NJS_TOKEN_STRING) {
+        return 0;
+    }
+
+    njs_string_get(&node->u.value, &key);
+
+    return njs_djb_hash(key.start, key.length);
+}
+
+
 static njs_int_t
 njs_generate(njs_vm_t *vm, njs_generator_t *generator, njs_parser_node_t *node)
 {
@@ -1660,16 +1702,14 @@ njs_generate_while_end(njs_vm_t *vm, njs_generator_t *generator,
     njs_parser_node_t *node)
 {
     njs_int_t                 ret;
-    njs_vmcode_cond_jump_t    *cond_jump;
     njs_generator_loop_ctx_t  *ctx;
 
     ctx = generator->context;
 
-    njs_generate_code(generator, njs_vmcode_cond_jump_t, cond_jump,
-                      NJS_VMCODE_IF_TRUE_JUMP, node->right);
-    cond_jump->offset = ctx->loop_offset - njs_code_offset(generator,
-                                                           cond_jump);
-    cond_jump->cond = node->right->index;
+    ret = njs_generate_loop_jump(vm, generator, ctx, node->right);
+    if (njs_slow_path(ret != NJS_OK)) {
+        return ret;
+    }
 
     njs_generate_patch_block_exit(vm, generator);
 
@@ -1727,16 +1767,14 @@ njs_generate_do_while_end(njs_vm_t *vm, njs_generator_t *generator,
     njs_parser_node_t *node)
 {
     njs_int_t                 ret;
-    njs_vmcode_cond_jump_t    *cond_jump;
     njs_generator_loop_ctx_t  *ctx;
 
     ctx = generator->context;
 
-    njs_generate_code(generator, njs_vmcode_cond_jump_t, cond_jump,
-                      NJS_VMCODE_IF_TRUE_JUMP, node->right);
-    cond_jump->offset = ctx->loop_offset
-                        - njs_code_offset(generator, cond_jump);
-    cond_jump->cond = node->right->index;
+    ret = njs_generate_loop_jump(vm, generator, ctx, node->right);
+    if (njs_slow_path(ret != NJS_OK)) {
+        return ret;
+    }
 
     njs_generate_patch_block_exit(vm, generator);
 
@@ -1901,7 +1939,6 @@ njs_generate_for_end(njs_vm_t *vm, njs_generator_t *generator,
 {
     njs_int_t                 ret;
     njs_parser_node_t         *condition;
-    njs_vmcode_cond_jump_t    *cond_jump;
     njs_generator_loop_ctx_t  *ctx;
 
     ctx = generator->context;
@@ -1909,11 +1946,10 @@ njs_generate_for_end(njs_vm_t *vm, njs_generator_t *generator,
     condition = node->right->left;
 
     if (condition != NULL) {
-        njs_generate_code(generator, njs_vmcode_cond_jump_t, cond_jump,
-                          NJS_VMCODE_IF_TRUE_JUMP, condition);
-        cond_jump->offset = ctx->loop_offset
-                            - njs_code_offset(generator, cond_jump);
-        cond_jump->cond = condition->index;
+        ret = njs_generate_loop_jump(vm, generator, ctx, condition);
+        if (njs_slow_path(ret != NJS_OK)) {
+            return ret;
+        }
 
         njs_generate_patch_block_exit(vm, generator);
 
@@ -1935,6 +1971,38 @@ njs_generate_for_end(njs_vm_t *vm, njs_generator_t *generator,
 }
 
 
+static njs_int_t
+njs_generate_loop_jump(njs_vm_t *vm, njs_generator_t *generator,
+    njs_generator_loop_ctx_t *ctx, njs_parser_node_t *cond)
+{
+    njs_vmcode_jump_t       *jump;
+    njs_vmcode_cond_jump_t  *cond_jump;
+
+    if (njs_scope_index_type(cond->index) == NJS_LEVEL_STATIC) {
+
+        /*
+         * The condition is a constant, the loop either always
+         * repeats or never does.
+         */
+
+        if (njs_is_true(njs_scope_value(vm, cond->index))) {
+            njs_generate_code(generator, njs_vmcode_jump_t, jump,
+                              NJS_VMCODE_JUMP, cond);
+            jump->offset = ctx->loop_offset - njs_code_offset(generator, jump);
+        }
+
+        return NJS_OK;
+    }
+
+    njs_generate_code(generator, njs_vmcode_cond_jump_t, cond_jump,
+                      NJS_VMCODE_IF_TRUE_JUMP, cond);
+    cond_jump->offset = ctx->loop_offset
+                        - njs_code_offset(generator, cond_jump);
+    cond_jump->cond = cond->index;
+
+    return NJS_OK;
+}
+
 static njs_int_t
 njs_generate_for_let_update(njs_vm_t *vm, njs_generator_t *generator,
     njs_parser_node_t *node)
@@ -3054,6 +3122,9 @@ njs_generate_global_property_set(njs_vm_t *vm, njs_generator_t *generator,
             return NJS_ERROR;
         }
 
+        prop_set->hash = njs_djb_hash(lex_entry->name.start,
+                                      lex_entry->name.length);
+
     }
 
     return NJS_OK;
@@ -3277,6 +3348,9 @@ njs_generate_assignment_end(njs_vm_t *vm, njs_generator_t *generator,
         if (njs_slow_path(ret != NJS_OK)) {
             return ret;
         }
+
+    } else {
+        prop_set->hash = njs_generate_key_hash(property);
     }
 
     node->index = expr->index;
@@ -3475,6 +3549,7 @@ njs_generate_operation_assignment_prop(njs_vm_t *vm, njs_generator_t *generator,
     prop_get->value = index;
     prop_get->object = object->index;
     prop_get->property = prop_index;
+    prop_get->hash = njs_generate_key_hash(property);
 
     njs_generator_next(generator, njs_generate, node->right);
 
@@ -3511,6 +3586,7 @@ njs_generate_operation_assignment_end(njs_vm_t *vm, njs_generator_t *generator,
     prop_set->value = node->index;
     prop_set->object = lvalue->left->index;
     prop_set->property = prop_index;
+    prop_set->hash = njs_generate_key_hash(lvalue->right);
 
     ret = njs_generate_children_indexes_release(vm, generator, lvalue);
     if (njs_slow_path(ret != NJS_OK)) {
@@ -3525,6 +3601,7 @@ static njs_int_t
 njs_generate_object(njs_vm_t *vm, njs_generator_t *generator,
     njs_parser_node_t *node)
 {
+    njs_int_t            ret;
     njs_vmcode_object_t  *object;
 
     node->index = njs_generate_object_dest_index(vm, generator, node);
@@ -3536,6 +3613,11 @@ njs_generate_object(njs_vm_t *vm, njs_generator_t *generator,
                       NJS_VMCODE_OBJECT, node);
     object->retval = node->index;
 
+    ret = njs_generate_object_shape(vm, node, &object->shape);
+    if (njs_slow_path(ret != NJS_OK)) {
+        return ret;
+    }
+
     /* Initialize object. */
 
     njs_generator_next(generator, njs_generate, node->left);
@@ -3546,6 +3628,98 @@ njs_generate_object(njs_vm_t *vm, njs_generator_t *generator,
 }
 
 
+/*
+ * The shape of an object literal consists of the leading properties with
+ * string literal keys in the literal order, it ends at the first accessor,
+ * __proto__ initializer or a key of another kind.  A repeated key keeps its
+ * first position as the later initialization replaces the value in place.
+ */
+
+static njs_int_t
+njs_generate_object_shape(njs_vm_t *vm, njs_parser_node_t *node,
+    njs_object_shape_t **shape)
+{
+    uint32_t                n, i, j, skip;
+    njs_value_t             *name;
+    njs_parser_node_t       *stmt, *assign, *inits[NJS_SHAPE_MAX_PROPS];
+    njs_lvlhsh_query_t      lhq;
+    njs_object_shape_t      *sh;
+    njs_object_shape_key_t  *key;
+
+    *shape = NULL;
+
+    n = 0;
+
+    for (stmt = node->left; stmt != NULL; stmt = stmt->left) {
+        n++;
+    }
+
+    /* The initializers are linked in the reverse order. */
+
+    skip = (n > NJS_SHAPE_MAX_PROPS) ? n - NJS_SHAPE_MAX_PROPS : 0;
+    n -= skip;
+
+    for (stmt = node->left; skip != 0; stmt = stmt->left) {
+        skip--;
+    }
+
+    for (i = n; i != 0; stmt = stmt->left) {
+        inits[--i] = stmt->right;
+    }
+
+    for (i = 0; i < n; i++) {
+        assign = inits[i];
+
+        if (assign->token_type != NJS_TOKEN_ASSIGNMENT
+            || assign->left->token_type != NJS_TOKEN_PROPERTY_INIT
+            || assign->left->right->token_type != NJS_TOKEN_STRING)
+        {
+            break;
+        }
+    }
+
+    n = i;
+
+    if (n == 0) {
+        return NJS_OK;
+    }
+
+    sh = njs_mp_alloc(vm->mem_pool, sizeof(njs_object_shape_t)
+                                    + n * sizeof(njs_object_shape_key_t));
+    if (njs_slow_path(sh == NULL)) {
+        njs_memory_error(vm);
+        return NJS_ERROR;
+    }
+
+    sh->nprops = 0;
+
+    for (i = 0; i < n; i++) {
+        name = &inits[i]->left->right->u.value;
+
+        for (j = 0; j < sh->nprops; j++) {
+            if (njs_string_eq(&sh->keys[j].name, name)) {
+                break;
+            }
+        }
+
+        if (j != sh->nprops) {
+            continue;
+        }
+
+        njs_object_property_init(&lhq, name, 0);
+
+        key = &sh->keys[sh->nprops++];
+
+        njs_value_assign(&key->name, name);
+        key->hash = lhq.key_hash;
+    }
+
+    *shape = sh;
+
+    return NJS_OK;
+}
+
+
 static njs_int_t
 njs_generate_property_accessor(njs_vm_t *vm, njs_generator_t *generator,
     njs_parser_node_t *node)
@@ -3899,15 +4073,26 @@ static njs_int_t
 njs_generate_3addr_operation_end(njs_vm_t *vm, njs_generator_t *generator,
     njs_parser_node_t *node)
 {
-    njs_bool_t          swap;
-    njs_parser_node_t   *left, *right;
-    njs_vmcode_3addr_t  *code;
+    njs_bool_t             swap;
+    njs_parser_node_t      *left, *right;
+    njs_vmcode_3addr_t     *code;
+    njs_vmcode_prop_get_t  *prop_get;
 
     left = node->left;
     right = node->right;
 
-    njs_generate_code(generator, njs_vmcode_3addr_t, code,
-                      node->u.operation, node);
+    if (node->u.operation == NJS_VMCODE_PROPERTY_GET) {
+        njs_generate_code(generator, njs_vmcode_prop_get_t, prop_get,
+                          NJS_VMCODE_PROPERTY_GET, node);
+
+        prop_get->hash = njs_generate_key_hash(right);
+
+        code = (njs_vmcode_3addr_t *) prop_get;
+
+    } else {
+        njs_generate_code(generator, njs_vmcode_3addr_t, code,
+                          node->u.operation, node);
+    }
 
     swap = *((njs_bool_t *) generator->context);
 
@@ -4153,6 +4338,7 @@ found:
     prop_get->value = index;
     prop_get->object = lvalue->left->index;
     prop_get->property = prop_index;
+    prop_get->hash = njs_generate_key_hash(lvalue->right);
 
     njs_generate_code(generator, njs_vmcode_3addr_t, code,
                       node->u.operation, node);
@@ -4165,6 +4351,7 @@ found:
     prop_set->value = index;
     prop_set->object = lvalue->left->index;
     prop_set->property = prop_index;
+    prop_set->hash = njs_generate_key_hash(lvalue->right);
 
     if (post) {
         ret = njs_generate_index_release(vm, generator, index);
@@ -4292,11 +4479,12 @@ njs_vm_code_t *
 njs_generate_scope(njs_vm_t *vm, njs_generator_t *generator,
     njs_parser_scope_t *scope, const njs_str_t *name)
 {
-    u_char         *p;
-    int64_t        nargs;
-    njs_int_t      ret;
-    njs_uint_t     index;
-    njs_vm_code_t  *code;
+    u_char            *p;
+    int64_t           nargs;
+    njs_int_t         ret;
+    njs_uint_t        index;
+    njs_vm_code_t     *code;
+    njs_queue_link_t  *link;
 
     generator->code_size = 128;
 
@@ -4367,6 +4555,8 @@ njs_generate_scope(njs_vm_t *vm, njs_generator_t *generator,
 
     } while (generator->state != NULL);
 
+    njs_generate_jumps_optimize(vm, generator);
+
     code = njs_arr_item(vm->codes, index);
     code->start = generator->code_start;
     code->end = generator->code_end;
@@ -4375,6 +4565,15 @@ njs_generate_scope(njs_vm_t *vm, njs_generator_t *generator,
 
     generator->code_size = generator->code_end - generator->code_start;
 
+    while (!njs_queue_is_empty(&generator->stack_free)) {
+        link = njs_queue_first(&generator->stack_free);
+        njs_queue_remove(link);
+
+        njs_mp_free(vm->mem_pool,
+                    njs_queue_link_data(link, njs_generator_stack_entry_t,
+                                        link));
+    }
+
     return code;
 }
 
@@ -4388,6 +4587,131 @@ njs_generate_scope_end(njs_vm_t *vm, njs_generator_t *generator,
 }
 
 
+/*
+ * Jumps to unconditional jumps and to conditional jumps whose outcome
+ * is already known are redirected to the final destination.
+ */
+
+static void
+njs_generate_jumps_optimize(njs_vm_t *vm, njs_generator_t *generator)
+{
+    u_char                  *p, *target;
+    size_t                  size;
+    njs_index_t             cond;
+    njs_vmcode_t            operation, jump;
+    njs_jump_off_t          *offset;
+    njs_vmcode_test_jump_t  *test_jump;
+    njs_vmcode_cond_jump_t  *cond_jump;
+
+    p = generator->code_start;
+
+    while (p < generator->code_end) {
+        operation = *(njs_vmcode_t *) p;
+        jump = operation;
+        cond = NJS_INDEX_NONE;
+
+        switch (operation) {
+        case NJS_VMCODE_JUMP:
+            offset = &((njs_vmcode_jump_t *) p)->offset;
+            break;
+
+        case NJS_VMCODE_IF_TRUE_JUMP:
+        case NJS_VMCODE_IF_FALSE_JUMP:
+            cond_jump = (njs_vmcode_cond_jump_t *) p;
+            offset = &cond_jump->offset;
+            cond = cond_jump->cond;
+            break;
+
+        case NJS_VMCODE_IF_EQUAL_JUMP:
+            offset = &((njs_vmcode_equal_jump_t *) p)->offset;
+            break;
+
+        case NJS_VMCODE_TEST_IF_TRUE:
+        case NJS_VMCODE_TEST_IF_FALSE:
+            test_jump = (njs_vmcode_test_jump_t *) p;
+            offset = &test_jump->offset;
+            cond = test_jump->retval;
+            jump = (operation == NJS_VMCODE_TEST_IF_TRUE)
+                   ? NJS_VMCODE_IF_TRUE_JUMP : NJS_VMCODE_IF_FALSE_JUMP;
+            break;
+
+        case NJS_VMCODE_COALESCE:
+            offset = &((njs_vmcode_test_jump_t *) p)->offset;
+            break;
+
+        default:
+            offset = NULL;
+            break;
+        }
+
+        if (offset != NULL) {
+            target = njs_generate_jump_target(vm, p + *offset, jump, cond);
+            *offset = target - p;
+        }
+
+        size = njs_vmcode_size[operation];
+        if (njs_slow_path(size == 0)) {
+            njs_assert(0);
+            return;
+        }
+
+        p += size;
+    }
+}
+
+
+static u_char *
+njs_generate_jump_target(njs_vm_t *vm, u_char *target,
+    njs_vmcode_t operation, njs_index_t cond)
+{
+    u_char                  *next;
+    njs_uint_t              n;
+    njs_vmcode_t            code;
+    njs_vmcode_cond_jump_t  *cond_jump;
+
+    for (n = 0; n < 8; n++) {
+        code = *(njs_vmcode_t *) target;
+
+        if (code == NJS_VMCODE_JUMP) {
+            next = target + ((njs_vmcode_jump_t *) target)->offset;
+
+        } else if (code == NJS_VMCODE_IF_TRUE_JUMP
+                   || code == NJS_VMCODE_IF_FALSE_JUMP)
+        {
+            cond_jump = (njs_vmcode_cond_jump_t *) target;
+
+            if (cond != NJS_INDEX_NONE && cond_jump->cond == cond) {
+                /* The same condition has just been tested. */
+                next = (code == operation) ? target + cond_jump->offset
+                                           : target + sizeof(*cond_jump);
+
+            } else if (njs_scope_index_type(cond_jump->cond)
+                       == NJS_LEVEL_STATIC)
+            {
+                next = (njs_is_true(njs_scope_value(vm, cond_jump->cond))
+                        == (code == NJS_VMCODE_IF_TRUE_JUMP))
+                       ? target + cond_jump->offset
+                       : target + sizeof(*cond_jump);
+
+            } else {
+                break;
+            }
+
+        } else {
+            break;
+        }
+
+        if (next == target) {
+            break;
+        }
+
+        target = next;
+    }
+
+    return target;
+}
+
+
 static int64_t
 njs_generate_lambda_variables(njs_vm_t *vm, njs_generator_t *generator,
     njs_parser_node_t *node)
@@ -4648,6 +4972,7 @@ njs_generate_method_call_arguments(njs_vm_t *vm, njs_generator_t *generator,
     method->ctor = node->ctor;
     method->object = prop->left->index;
     method->method = prop->right->index;
+    method->hash = njs_generate_key_hash(prop->right);
     method->nargs = 0;
 
     njs_generator_next(generator, njs_generate,
@@ -5427,6 +5752,9 @@ njs_generate_global_reference(njs_vm_t *vm, njs_generator_t *generator,
         return NJS_ERROR;
     }
 
+    prop_get->hash = njs_djb_hash(lex_entry->name.start,
+                                  lex_entry->name.length);
+
     node->index = index;
 
     if (!exception) {
@@ -18,6 +18,7 @@ typedef njs_int_t (*njs_generator_state_func_t)(njs_vm_t *vm,
 struct njs_generator_s {
     njs_generator_state_func_t      state;
     njs_queue_t                     stack;
+    njs_queue_t                     stack_free;
     njs_parser_node_t               *node;
     void                            *context;
 
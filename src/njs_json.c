@@ -8,15 +8,33 @@
 #include <njs_main.h>
 
 
+#define NJS_JSON_ONES  0x0101010101010101ULL
+#define NJS_JSON_HIGH  0x8080808080808080ULL
+
+
 typedef struct {
     njs_vm_t                   *vm;
     njs_mp_t                   *pool;
     njs_uint_t                 depth;
+    njs_bool_t                 lazy;
     const u_char               *start;
     const u_char               *end;
 } njs_json_parse_ctx_t;
 
 
+/*
+ * A property whose object or array value is not parsed until accessed,
+ * see njs_json_parse_lazy().  The property comes first, so the record
+ * is found by the property stored in the object hash.
+ */
+
+typedef struct {
+    njs_object_prop_t          prop;
+    const u_char               *start;
+    const u_char               *end;
+} njs_json_lazy_t;
+
+
 typedef struct {
     njs_value_t                value;
 
@@ -45,9 +63,21 @@ typedef struct {
     njs_str_t                  space;
     u_char                     space_buf[16];
     uint32_t                   keys_type;
+    uint8_t                    array_keys;    /* 1 bit */
+    uint8_t                    drained;       /* 1 bit */
+
+    njs_json_writer_t          writer;
+    void                       *data;
 } njs_json_stringify_t;
 
 
+/*
+ * The output of njs_vm_json_stringify_to() is passed to the writer
+ * in chunks of about this size.
+ */
+#define NJS_JSON_CHUNK_SIZE    16384
+
+
 static const u_char *njs_json_parse_value(njs_json_parse_ctx_t *ctx,
     njs_value_t *value, const u_char *p);
 static const u_char *njs_json_parse_object(njs_json_parse_ctx_t *ctx,
@@ -58,7 +88,13 @@ static const u_char *njs_json_parse_string(njs_json_parse_ctx_t *ctx,
     njs_value_t *value, const u_char *p);
 static const u_char *njs_json_parse_number(njs_json_parse_ctx_t *ctx,
     njs_value_t *value, const u_char *p);
+static njs_object_prop_t *njs_json_parse_lazy(njs_json_parse_ctx_t *ctx,
+    njs_value_t *name, const u_char *start);
+static njs_int_t njs_json_lazy_value(njs_vm_t *vm, njs_object_prop_t *prop,
+    njs_value_t *value, njs_value_t *setval, njs_value_t *retval);
 njs_inline uint32_t njs_json_unicode(const u_char *p);
+static const u_char *njs_json_skip_chars(const u_char *p,
+    const u_char *end);
 static const u_char *njs_json_skip_space(const u_char *start,
     const u_char *end);
 
@@ -68,6 +104,10 @@ static njs_int_t njs_json_internalize_property(njs_vm_t *vm,
 static void njs_json_parse_exception(njs_json_parse_ctx_t *ctx,
     const char *msg, const u_char *pos);
 
+static njs_int_t njs_json_stringify_init(njs_vm_t *vm,
+    njs_json_stringify_t *stringify, njs_value_t *replacer, njs_value_t *space);
+static njs_int_t njs_json_stringify_flush(njs_json_stringify_t *stringify,
+    njs_chb_t *chain);
 static njs_int_t njs_json_stringify_iterator(njs_json_stringify_t *stringify,
     njs_value_t *value, njs_value_t *retval);
 static njs_function_t *njs_object_to_json_function(njs_vm_t *vm,
@@ -96,13 +136,30 @@ njs_json_parse(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
     njs_index_t unused, njs_value_t *retval)
 {
     njs_int_t             ret;
-    njs_value_t           *text, value, lvalue, wrapper;
+    njs_bool_t            lazy;
+    njs_value_t           *text, value, lvalue, wrapper, retval_lazy;
     njs_object_t          *obj;
     const u_char          *p, *end;
     const njs_value_t     *reviver;
     njs_string_prop_t     string;
     njs_json_parse_ctx_t  ctx;
 
+    static const njs_value_t  lazy_str = njs_string("lazy");
+
+    reviver = njs_arg(args, nargs, 2);
+
+    lazy = 0;
+
+    if (njs_is_object(reviver) && !njs_is_function(reviver)) {
+        ret = njs_value_property(vm, njs_value_arg(reviver),
+                                 njs_value_arg(&lazy_str), &retval_lazy);
+        if (njs_slow_path(ret == NJS_ERROR)) {
+            return ret;
+        }
+
+        lazy = njs_bool(&retval_lazy);
+    }
+
     text = njs_lvalue_arg(&lvalue, args, nargs, 1);
 
     if (njs_slow_path(!njs_is_string(text))) {
@@ -123,6 +180,12 @@ njs_json_parse(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
     ctx.start = string.start;
     ctx.end = end;
 
+    /*
+     * The data of short strings is stored in the value itself,
+     * it cannot be referenced by lazy values.
+     */
+    ctx.lazy = lazy && text->short_string.size == NJS_STRING_LONG;
+
     p = njs_json_skip_space(p, end);
     if (njs_slow_path(p == end)) {
         njs_json_parse_exception(&ctx, "Unexpected end of input", p);
@@ -140,8 +203,6 @@ njs_json_parse(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
         return NJS_ERROR;
     }
 
-    reviver = njs_arg(args, nargs, 2);
-
     if (njs_slow_path(njs_is_function(reviver))) {
         obj = njs_json_wrap_value(vm, &wrapper, &value);
         if (njs_slow_path(obj == NULL)) {
@@ -176,22 +237,38 @@ static njs_int_t
 njs_json_stringify(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
     njs_index_t unused, njs_value_t *retval)
 {
-    size_t                length;
-    int64_t               i64;
-    njs_int_t             i;
     njs_int_t             ret;
-    njs_value_t           *replacer, *space;
-    const u_char          *p;
-    njs_string_prop_t     prop;
-    njs_json_stringify_t  *stringify, json_stringify;
+    njs_json_stringify_t  stringify;
+
+    ret = njs_json_stringify_init(vm, &stringify, njs_arg(args, nargs, 2),
+                                  njs_arg(args, nargs, 3));
+    if (njs_slow_path(ret != NJS_OK)) {
+        return ret;
+    }
+
+    return njs_json_stringify_iterator(&stringify, njs_arg(args, nargs, 1),
+                                       retval);
+}
 
-    stringify = &json_stringify;
+
+static njs_int_t
+njs_json_stringify_init(njs_vm_t *vm, njs_json_stringify_t *stringify,
+    njs_value_t *replacer, njs_value_t *space)
+{
+    size_t             length;
+    int64_t            i64;
+    njs_int_t          i;
+    njs_int_t          ret;
+    const u_char       *p;
+    njs_string_prop_t  prop;
 
     stringify->vm = vm;
     stringify->depth = 0;
     stringify->keys_type = NJS_ENUM_STRING;
-
-    replacer = njs_arg(args, nargs, 2);
+    stringify->array_keys = 0;
+    stringify->drained = 0;
+    stringify->writer = NULL;
+    stringify->data = NULL;
 
     if (njs_is_function(replacer) || njs_is_array(replacer)) {
         stringify->replacer = *replacer;
@@ -206,8 +283,6 @@ njs_json_stringify(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
         njs_set_undefined(&stringify->replacer);
     }
 
-    space = njs_arg(args, nargs, 3);
-
     if (njs_is_object(space)) {
         if (njs_is_object_number(space)) {
             ret = njs_value_to_numeric(vm, space, space);
@@ -255,8 +330,7 @@ njs_json_stringify(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
         break;
      }
 
-    return njs_json_stringify_iterator(stringify, njs_arg(args, nargs, 1),
-                                       retval);
+    return NJS_OK;
 
 memory_error:
 
@@ -278,6 +352,28 @@ njs_vm_json_stringify(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
 }
 
 
+njs_int_t
+njs_vm_json_stringify_to(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
+    njs_json_writer_t writer, void *data)
+{
+    njs_int_t             ret;
+    njs_value_t           retval;
+    njs_json_stringify_t  stringify;
+
+    ret = njs_json_stringify_init(vm, &stringify, njs_arg(args, nargs, 1),
+                                  njs_arg(args, nargs, 2));
+    if (njs_slow_path(ret != NJS_OK)) {
+        return ret;
+    }
+
+    stringify.writer = writer;
+    stringify.data = data;
+
+    return njs_json_stringify_iterator(&stringify, njs_arg(args, nargs, 0),
+                                       &retval);
+}
+
+
 static const u_char *
 njs_json_parse_value(njs_json_parse_ctx_t *ctx, njs_value_t *value,
     const u_char *p)
@@ -294,7 +390,9 @@ njs_json_parse_value(njs_json_parse_ctx_t *ctx, njs_value_t *value,
 
     case 't':
         if (njs_fast_path(ctx->end - p >= 4 && memcmp(p, "true", 4) == 0)) {
-            *value = njs_value_true;
+            if (value != NULL) {
+                *value = njs_value_true;
+            }
 
             return p + 4;
         }
@@ -303,7 +401,9 @@ njs_json_parse_value(njs_json_parse_ctx_t *ctx, njs_value_t *value,
 
     case 'f':
         if (njs_fast_path(ctx->end - p >= 5 && memcmp(p, "false", 5) == 0)) {
-            *value = njs_value_false;
+            if (value != NULL) {
+                *value = njs_value_false;
+            }
 
             return p + 5;
         }
@@ -312,7 +412,9 @@ njs_json_parse_value(njs_json_parse_ctx_t *ctx, njs_value_t *value,
 
     case 'n':
         if (njs_fast_path(ctx->end - p >= 4 && memcmp(p, "null", 4) == 0)) {
-            *value = njs_value_null;
+            if (value != NULL) {
+                *value = njs_value_null;
+            }
 
             return p + 4;
         }
@@ -337,8 +439,10 @@ njs_json_parse_object(njs_json_parse_ctx_t *ctx, njs_value_t *value,
     const u_char *p)
 {
     njs_int_t           ret;
+    njs_bool_t          empty;
     njs_object_t        *object;
-    njs_value_t         prop_name, prop_value;
+    njs_value_t         prop_name, prop_value, *name;
+    const u_char        *start;
     njs_object_prop_t   *prop;
     njs_lvlhsh_query_t  lhq;
 
@@ -347,12 +451,21 @@ njs_json_parse_object(njs_json_parse_ctx_t *ctx, njs_value_t *value,
         return NULL;
     }
 
-    object = njs_object_alloc(ctx->vm);
-    if (njs_slow_path(object == NULL)) {
-        goto memory_error;
+    /* A NULL value means the object is validated and skipped. */
+
+    object = NULL;
+    name = NULL;
+
+    if (value != NULL) {
+        object = njs_object_alloc(ctx->vm);
+        if (njs_slow_path(object == NULL)) {
+            goto memory_error;
+        }
+
+        name = &prop_name;
     }
 
-    prop = NULL;
+    empty = 1;
 
     for ( ;; ) {
         p = njs_json_skip_space(p + 1, ctx->end);
@@ -362,7 +475,7 @@ njs_json_parse_object(njs_json_parse_ctx_t *ctx, njs_value_t *value,
 
         if (*p != '"') {
             if (njs_fast_path(*p == '}')) {
-                if (njs_slow_path(prop != NULL)) {
+                if (njs_slow_path(!empty)) {
                     njs_json_parse_exception(ctx, "Trailing comma", p - 1);
                     return NULL;
                 }
@@ -373,7 +486,7 @@ njs_json_parse_object(njs_json_parse_ctx_t *ctx, njs_value_t *value,
             goto error_token;
         }
 
-        p = njs_json_parse_string(ctx, &prop_name, p);
+        p = njs_json_parse_string(ctx, name, p);
         if (njs_slow_path(p == NULL)) {
             /* The exception is set by the called function. */
             return NULL;
@@ -389,15 +502,41 @@ njs_json_parse_object(njs_json_parse_ctx_t *ctx, njs_value_t *value,
             goto error_end;
         }
 
-        p = njs_json_parse_value(ctx, &prop_value, p);
-        if (njs_slow_path(p == NULL)) {
-            /* The exception is set by the called function. */
-            return NULL;
+        empty = 0;
+
+        if (object == NULL) {
+            p = njs_json_parse_value(ctx, NULL, p);
+            if (njs_slow_path(p == NULL)) {
+                return NULL;
+            }
+
+            goto next;
         }
 
-        prop = njs_object_prop_alloc(ctx->vm, &prop_name, &prop_value, 1);
-        if (njs_slow_path(prop == NULL)) {
-            goto memory_error;
+        if (ctx->lazy && (*p == '{' || *p == '[')) {
+            start = p;
+
+            p = njs_json_parse_value(ctx, NULL, p);
+            if (njs_slow_path(p == NULL)) {
+                return NULL;
+            }
+
+            prop = njs_json_parse_lazy(ctx, &prop_name, start);
+            if (njs_slow_path(prop == NULL)) {
+                goto memory_error;
+            }
+
+        } else {
+            p = njs_json_parse_value(ctx, &prop_value, p);
+            if (njs_slow_path(p == NULL)) {
+                /* The exception is set by the called function. */
+                return NULL;
+            }
+
+            prop = njs_object_prop_alloc(ctx->vm, &prop_name, &prop_value, 1);
+            if (njs_slow_path(prop == NULL)) {
+                goto memory_error;
+            }
         }
 
         njs_string_get(&prop_name, &lhq.key);
@@ -409,10 +548,12 @@ njs_json_parse_object(njs_json_parse_ctx_t *ctx, njs_value_t *value,
 
         ret = njs_lvlhsh_insert(&object->hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(ctx->vm, "lvlhsh insert/replace failed");
+            njs_memory_error(ctx->vm);
             return NULL;
         }
 
+    next:
+
         p = njs_json_skip_space(p, ctx->end);
         if (njs_slow_path(p == ctx->end)) {
             goto error_end;
@@ -427,7 +568,9 @@ njs_json_parse_object(njs_json_parse_ctx_t *ctx, njs_value_t *value,
         }
     }
 
-    njs_set_object(value, object);
+    if (object != NULL) {
+        njs_set_object(value, object);
+    }
 
     ctx->depth++;
 
@@ -467,9 +610,15 @@ njs_json_parse_array(njs_json_parse_ctx_t *ctx, njs_value_t *value,
         return NULL;
     }
 
-    array = njs_array_alloc(ctx->vm, 0, 0, NJS_ARRAY_SPARE);
-    if (njs_slow_path(array == NULL)) {
-        return NULL;
+    /* A NULL value means the array is validated and skipped. */
+
+    array = NULL;
+
+    if (value != NULL) {
+        array = njs_array_alloc(ctx->vm, 0, 0, NJS_ARRAY_SPARE);
+        if (njs_slow_path(array == NULL)) {
+            return NULL;
+        }
     }
 
     empty = 1;
@@ -489,14 +638,22 @@ njs_json_parse_array(njs_json_parse_ctx_t *ctx, njs_value_t *value,
             break;
         }
 
-        p = njs_json_parse_value(ctx, &element, p);
-        if (njs_slow_path(p == NULL)) {
-            return NULL;
-        }
+        if (array == NULL) {
+            p = njs_json_parse_value(ctx, NULL, p);
+            if (njs_slow_path(p == NULL)) {
+                return NULL;
+            }
 
-        ret = njs_array_add(ctx->vm, array, &element);
-        if (njs_slow_path(ret != NJS_OK)) {
-            return NULL;
+        } else {
+            p = njs_json_parse_value(ctx, &element, p);
+            if (njs_slow_path(p == NULL)) {
+                return NULL;
+            }
+
+            ret = njs_array_add(ctx->vm, array, &element);
+            if (njs_slow_path(ret != NJS_OK)) {
+                return NULL;
+            }
         }
 
         empty = 0;
@@ -515,7 +672,9 @@ njs_json_parse_array(njs_json_parse_ctx_t *ctx, njs_value_t *value,
         }
     }
 
-    njs_set_array(value, array);
+    if (array != NULL) {
+        njs_set_array(value, array);
+    }
 
     ctx->depth++;
 
@@ -543,7 +702,7 @@ njs_json_parse_string(njs_json_parse_ctx_t *ctx, njs_value_t *value,
     size_t        size, surplus;
     uint32_t      utf, utf_low;
     njs_int_t     ret;
-    const u_char  *start, *last;
+    const u_char  *start, *last, *scanned;
 
     enum {
         sw_usual = 0,
@@ -559,8 +718,20 @@ njs_json_parse_string(njs_json_parse_ctx_t *ctx, njs_value_t *value,
     dst = NULL;
     state = 0;
     surplus = 0;
+    scanned = start;
 
     for (p = start; p < ctx->end; p++) {
+
+        if (state == sw_usual && p >= scanned) {
+            p = njs_json_skip_chars(p, ctx->end);
+            if (p == ctx->end) {
+                break;
+            }
+
+            /* The bytes up to "scanned" are tested one by one. */
+            scanned = p + 8;
+        }
+
         ch = *p;
 
         switch (state) {
@@ -645,6 +816,10 @@ njs_json_parse_string(njs_json_parse_ctx_t *ctx, njs_value_t *value,
     /* Points to the ending quote mark. */
     last = p;
 
+    if (value == NULL) {
+        return last + 1;
+    }
+
     size = last - start - surplus;
 
     if (surplus != 0) {
@@ -769,7 +944,10 @@ njs_json_parse_number(njs_json_parse_ctx_t *ctx, njs_value_t *value,
     start = p;
     num = njs_number_dec_parse(&p, ctx->end, 0);
     if (p != start) {
-        njs_set_number(value, sign * num);
+        if (value != NULL) {
+            njs_set_number(value, sign * num);
+        }
+
         return p;
     }
 
@@ -781,6 +959,163 @@ error:
 }
 
 
+static njs_object_prop_t *
+njs_json_parse_lazy(njs_json_parse_ctx_t *ctx, njs_value_t *name,
+    const u_char *start)
+{
+    njs_json_lazy_t    *lazy;
+    njs_object_prop_t  *prop;
+
+    lazy = njs_mp_align(ctx->vm->mem_pool, sizeof(njs_value_t),
+                        sizeof(njs_json_lazy_t));
+    if (njs_slow_path(lazy == NULL)) {
+        return NULL;
+    }
+
+    lazy->start = start;
+    lazy->end = ctx->end;
+
+    prop = &lazy->prop;
+
+    njs_value_assign(&prop->name, name);
+
+    prop->type = NJS_PROPERTY_HANDLER;
+    prop->enum_in_object_hash = 0;
+    prop->writable = 1;
+    prop->enumerable = 1;
+    prop->configurable = 1;
+
+    prop->u.value.type = NJS_INVALID;
+    prop->u.value.data.truth = 1;
+    njs_prop_magic16(prop) = 0;
+    njs_prop_magic32(prop) = 0;
+    njs_prop_handler(prop) = njs_json_lazy_value;
+
+    return prop;
+}
+
+
+/*
+ * Looks up the lazy property which the handler was called for, starting
+ * from the object itself and, for reading, following its prototypes.
+ * The handler may be called with a copy of the property, so the record
+ * is taken from the property stored in the object hash.
+ */
+
+static njs_json_lazy_t *
+njs_json_lazy_prop(njs_vm_t *vm, njs_value_t *value, njs_object_prop_t *prop,
+    njs_bool_t own)
+{
+    njs_int_t           ret;
+    njs_object_t        *object;
+    njs_object_prop_t   *p;
+    njs_lvlhsh_query_t  lhq;
+
+    if (njs_slow_path(!njs_is_string(&prop->name))) {
+        return NULL;
+    }
+
+    if (njs_is_object(value)) {
+        object = njs_object(value);
+
+    } else if (own) {
+        return NULL;
+
+    } else if (njs_is_string(value)) {
+        object = &vm->string_object;
+
+    } else if (njs_is_number(value) || njs_is_boolean(value)
+               || njs_is_symbol(value))
+    {
+        object = njs_vm_proto(vm, njs_primitive_prototype_index(value->type));
+
+    } else {
+        return NULL;
+    }
+
+    njs_string_get(&prop->name, &lhq.key);
+    lhq.key_hash = njs_djb_hash(lhq.key.start, lhq.key.length);
+    lhq.proto = &njs_object_hash_proto;
+
+    do {
+        ret = njs_lvlhsh_find(&object->hash, &lhq);
+
+        if (ret == NJS_OK) {
+            p = lhq.value;
+
+            if (p->type == NJS_PROPERTY_HANDLER
+                && njs_prop_handler(p) == njs_json_lazy_value)
+            {
+                return (njs_json_lazy_t *) p;
+            }
+
+            return NULL;
+        }
+
+        object = object->__proto__;
+
+    } while (!own && object != NULL);
+
+    return NULL;
+}
+
+
+static njs_int_t
+njs_json_lazy_value(njs_vm_t *vm, njs_object_prop_t *prop,
+    njs_value_t *value, njs_value_t *setval, njs_value_t *retval)
+{
+    const u_char          *p;
+    njs_json_lazy_t       *lazy;
+    njs_json_parse_ctx_t  ctx;
+
+    if (setval != NULL) {
+        lazy = njs_json_lazy_prop(vm, value, prop, 1);
+        if (lazy == NULL) {
+            return NJS_DECLINED;
+        }
+
+        lazy->prop.type = NJS_PROPERTY;
+        njs_value_assign(njs_prop_value(&lazy->prop), setval);
+
+        return NJS_OK;
+    }
+
+    if (retval == NULL) {
+        return NJS_DECLINED;
+    }
+
+    lazy = njs_json_lazy_prop(vm, value, prop, 0);
+    if (njs_slow_path(lazy == NULL)) {
+        return NJS_DECLINED;
+    }
+
+    ctx.vm = vm;
+    ctx.pool = vm->mem_pool;
+    ctx.depth = NJS_JSON_MAX_DEPTH;
+    ctx.lazy = 1;
+    ctx.start = lazy->start;
+    ctx.end = lazy->end;
+
+    p = njs_json_parse_value(&ctx, retval, lazy->start);
+    if (njs_slow_path(p == NULL)) {
+        return NJS_ERROR;
+    }
+
+    /*
+     * The value is parsed once, the following reads return the same one.
+     * The source range is not referenced anymore.
+     */
+
+    lazy->prop.type = NJS_PROPERTY;
+    njs_value_assign(njs_prop_value(&lazy->prop), retval);
+
+    lazy->start = NULL;
+    lazy->end = NULL;
+
+    return NJS_OK;
+}
+
+
 njs_inline uint32_t
 njs_json_unicode(const u_char *p)
 {
@@ -805,6 +1140,38 @@ njs_json_unicode(const u_char *p)
 }
 
 
+/*
+ * Skips ordinary string characters eight bytes at a time.  A word is
+ * ordinary if none of its bytes is a quote, a backslash or a control
+ * character.  The remaining bytes are left to the byte-wise parser.
+ */
+
+static const u_char *
+njs_json_skip_chars(const u_char *p, const u_char *end)
+{
+    uint64_t  word, quote, backslash;
+
+    while (end - p >= 8) {
+        memcpy(&word, p, 8);
+
+        quote = word ^ (NJS_JSON_ONES * '"');
+        backslash = word ^ (NJS_JSON_ONES * '\\');
+
+        if ((((quote - NJS_JSON_ONES) & ~quote)
+             | ((backslash - NJS_JSON_ONES) & ~backslash)
+             | ((word - NJS_JSON_ONES * ' ') & ~word))
+            & NJS_JSON_HIGH)
+        {
+            break;
+        }
+
+        p += 8;
+    }
+
+    return p;
+}
+
+
 static const u_char *
 njs_json_skip_space(const u_char *start, const u_char *end)
 {
@@ -974,9 +1341,14 @@ njs_json_push_stringify_state(njs_json_stringify_t *stringify,
         state->keys = njs_array(&stringify->replacer);
 
     } else if (state->array) {
-        state->keys = njs_array_keys(stringify->vm, value, 1);
-        if (njs_slow_path(state->keys == NULL)) {
-            return NULL;
+
+        /* JSON.stringify() visits array elements by index. */
+
+        if (stringify->array_keys) {
+            state->keys = njs_array_keys(stringify->vm, value, 1);
+            if (njs_slow_path(state->keys == NULL)) {
+                return NULL;
+            }
         }
 
         ret = njs_object_length(stringify->vm, &state->value, &state->length);
@@ -1096,6 +1468,15 @@ njs_json_stringify_iterator(njs_json_stringify_t *stringify,
     NJS_CHB_MP_INIT(&chain, stringify->vm);
 
     for ( ;; ) {
+        if (stringify->writer != NULL
+            && njs_chb_size(&chain) >= NJS_JSON_CHUNK_SIZE)
+        {
+            ret = njs_json_stringify_flush(stringify, &chain);
+            if (njs_slow_path(ret != NJS_OK)) {
+                return ret;
+            }
+        }
+
         if (state->index == 0) {
             njs_chb_append(&chain, state->array ? "[" : "{", 1);
             njs_json_stringify_indent(stringify, &chain, 0);
@@ -1190,20 +1571,38 @@ done:
      * Stripping the wrapper's data.
      */
 
-    njs_chb_drain(&chain, njs_length("{\"\":"));
     njs_chb_drop(&chain, njs_length("}"));
 
     if (stringify->space.length != 0) {
-        njs_chb_drain(&chain, njs_length("\n "));
         njs_chb_drop(&chain, njs_length("\n"));
     }
 
+    if (!stringify->drained) {
+        njs_chb_drain(&chain, njs_length("{\"\":"));
+
+        if (stringify->space.length != 0) {
+            njs_chb_drain(&chain, njs_length("\n "));
+        }
+
+        stringify->drained = 1;
+    }
+
     size = njs_chb_size(&chain);
     if (njs_slow_path(size < 0)) {
         njs_chb_destroy(&chain);
         goto memory_error;
     }
 
+    if (stringify->writer != NULL) {
+        ret = njs_json_stringify_flush(stringify, &chain);
+        if (njs_slow_path(ret != NJS_OK)) {
+            return ret;
+        }
+
+        njs_set_undefined(retval);
+        goto release;
+    }
+
     if (size == 0) {
         njs_set_undefined(retval);
         goto release;
@@ -1229,6 +1628,47 @@ memory_error:
 }
 
 
+static njs_int_t
+njs_json_stringify_flush(njs_json_stringify_t *stringify, njs_chb_t *chain)
+{
+    njs_int_t       ret;
+    njs_chb_node_t  *n;
+
+    if (njs_slow_path(chain->error)) {
+        njs_memory_error(stringify->vm);
+        return NJS_ERROR;
+    }
+
+    if (!stringify->drained) {
+        njs_chb_drain(chain, njs_length("{\"\":"));
+
+        if (stringify->space.length != 0) {
+            njs_chb_drain(chain, njs_length("\n "));
+        }
+
+        stringify->drained = 1;
+    }
+
+    for (n = chain->nodes; n != NULL; n = n->next) {
+        if (njs_chb_node_size(n) == 0) {
+            continue;
+        }
+
+        ret = stringify->writer(stringify->vm, n->start, njs_chb_node_size(n),
+                                stringify->data);
+        if (njs_slow_path(ret != NJS_OK)) {
+            return ret;
+        }
+    }
+
+    njs_chb_destroy(chain);
+
+    NJS_CHB_MP_INIT(chain, stringify->vm);
+
+    return NJS_OK;
+}
+
+
 static njs_function_t *
 njs_object_to_json_function(njs_vm_t *vm, njs_value_t *value)
 {
@@ -1463,8 +1903,7 @@ njs_json_append_string(njs_chb_t *chain, const njs_value_t *value, char quote)
 {
     size_t             size;
     u_char             c, *dst, *dst_end;
-    njs_bool_t         utf8;
-    const u_char       *p, *end;
+    const u_char       *p, *q, *end, *last;
     njs_string_prop_t  string;
 
     static char  hex2char[16] = { '0', '1', '2', '3', '4', '5', '6', '7',
@@ -1474,7 +1913,6 @@ njs_json_append_string(njs_chb_t *chain, const njs_value_t *value, char quote)
 
     p = string.start;
     end = p + string.size;
-    utf8 = (string.length != 0 && string.length != string.size);
 
     size = njs_max(string.size + 2, 7);
     dst = njs_chb_reserve(chain, size);
@@ -1488,68 +1926,97 @@ njs_json_append_string(njs_chb_t *chain, const njs_value_t *value, char quote)
     njs_chb_written(chain, 1);
 
     while (p < end) {
-        if (njs_slow_path(dst_end <= dst + njs_length("\\uXXXX"))) {
-            size = njs_max(end - p + 1, 6);
-            dst = njs_chb_reserve(chain, size);
-            if (njs_slow_path(dst == NULL)) {
-                return;
+
+        /*
+         * The bytes which do not need escaping, including UTF-8
+         * sequences, are copied as is in runs.
+         */
+
+        q = p;
+
+        for ( ;; ) {
+            q = njs_json_skip_chars(q, end);
+            last = (end - q > 8) ? q + 8 : end;
+
+            while (q < last
+                   && *q >= ' '
+                   && *q != '\\'
+                   && (*q != '\"' || quote != '\"'))
+            {
+                q++;
             }
 
-            dst_end = dst + size;
+            if (q != last || q == end) {
+                break;
+            }
         }
 
-        if (njs_slow_path(*p < ' '
-                          || *p == '\\'
-                          || (*p == '\"' && quote == '\"')))
-        {
-            c = (u_char) *p++;
-            *dst++ = '\\';
-            njs_chb_written(chain, 2);
+        if (q != p) {
+            size = q - p;
 
-            switch (c) {
-            case '\\':
-                *dst++ = '\\';
-                break;
-            case '"':
-                *dst++ = '\"';
-                break;
-            case '\r':
-                *dst++ = 'r';
-                break;
-            case '\n':
-                *dst++ = 'n';
-                break;
-            case '\t':
-                *dst++ = 't';
-                break;
-            case '\b':
-                *dst++ = 'b';
-                break;
-            case '\f':
-                *dst++ = 'f';
-                break;
-            default:
-                *dst++ = 'u';
-                *dst++ = '0';
-                *dst++ = '0';
-                *dst++ = hex2char[(c & 0xf0) >> 4];
-                *dst++ = hex2char[c & 0x0f];
-                njs_chb_written(chain, 4);
+            if (njs_slow_path((size_t) (dst_end - dst) < size + 1)) {
+                dst = njs_chb_reserve(chain, size + 1);
+                if (njs_slow_path(dst == NULL)) {
+                    return;
+                }
+
+                dst_end = dst + size + 1;
             }
 
-            continue;
+            dst = njs_cpymem(dst, p, size);
+            njs_chb_written(chain, size);
+
+            p = q;
+
+            if (p == end) {
+                break;
+            }
         }
 
-        if (utf8) {
-            /* UTF-8 string. */
-            dst = njs_utf8_copy(dst, &p, end);
+        if (njs_slow_path(dst_end <= dst + njs_length("\\uXXXX"))) {
+            size = njs_max(end - p + 1, 6);
+            dst = njs_chb_reserve(chain, size);
+            if (njs_slow_path(dst == NULL)) {
+                return;
+            }
 
-        } else {
-            /* ASCII string. */
-            *dst++ = *p++;
+            dst_end = dst + size;
         }
 
-        njs_chb_written(chain, dst - chain->last->pos);
+        c = (u_char) *p++;
+        *dst++ = '\\';
+        njs_chb_written(chain, 2);
+
+        switch (c) {
+        case '\\':
+            *dst++ = '\\';
+            break;
+        case '"':
+            *dst++ = '\"';
+            break;
+        case '\r':
+            *dst++ = 'r';
+            break;
+        case '\n':
+            *dst++ = 'n';
+            break;
+        case '\t':
+            *dst++ = 't';
+            break;
+        case '\b':
+            *dst++ = 'b';
+            break;
+        case '\f':
+            *dst++ = 'f';
+            break;
+        default:
+            *dst++ = 'u';
+            *dst++ = '0';
+            *dst++ = '0';
+            *dst++ = hex2char[(c & 0xf0) >> 4];
+            *dst++ = hex2char[c & 0x0f];
+            njs_chb_written(chain, 4);
+        }
     }
 
     njs_chb_append(chain, &quote, 1);
@@ -1990,6 +2457,7 @@ njs_vm_value_dump(njs_vm_t *vm, njs_str_t *retval, njs_value_t *value,
 
     njs_set_undefined(&stringify->replacer);
     stringify->keys_type = NJS_ENUM_STRING | NJS_ENUM_SYMBOL;
+    stringify->array_keys = 1;
     indent = njs_min(indent, 10);
     stringify->space.length = indent;
     stringify->space.start = stringify->space_buf;
@@ -307,6 +307,7 @@ njs_lexer_init(njs_vm_t *vm, njs_lexer_t *lexer, njs_str_t *file,
     lexer->mem_pool = vm->mem_pool;
 
     njs_queue_init(&lexer->preread);
+    njs_queue_init(&lexer->free);
 
     return njs_lexer_in_stack_init(lexer);
 }
@@ -415,11 +416,21 @@ njs_inline njs_lexer_token_t *
 njs_lexer_next_token(njs_lexer_t *lexer)
 {
     njs_int_t          ret;
+    njs_queue_link_t   *lnk;
     njs_lexer_token_t  *token;
 
-    token = njs_mp_zalloc(lexer->mem_pool, sizeof(njs_lexer_token_t));
-    if (njs_slow_path(token == NULL)) {
-        return NULL;
+    if (!njs_queue_is_empty(&lexer->free)) {
+        lnk = njs_queue_first(&lexer->free);
+        njs_queue_remove(lnk);
+
+        token = njs_queue_link_data(lnk, njs_lexer_token_t, link);
+        njs_memzero(token, sizeof(njs_lexer_token_t));
+
+    } else {
+        token = njs_mp_zalloc(lexer->mem_pool, sizeof(njs_lexer_token_t));
+        if (njs_slow_path(token == NULL)) {
+            return NULL;
+        }
     }
 
     do {
@@ -537,7 +548,23 @@ njs_lexer_consume_token(njs_lexer_t *lexer, unsigned length)
 
         njs_queue_remove(lnk);
 
-        njs_mp_free(lexer->mem_pool, token);
+        /* Consumed tokens are reused for the next tokens. */
+        njs_queue_insert_head(&lexer->free, lnk);
+    }
+}
+
+
+void
+njs_lexer_tokens_free(njs_lexer_t *lexer)
+{
+    njs_queue_link_t  *lnk;
+
+    while (!njs_queue_is_empty(&lexer->free)) {
+        lnk = njs_queue_first(&lexer->free);
+        njs_queue_remove(lnk);
+
+        njs_mp_free(lexer->mem_pool,
+                    njs_queue_link_data(lnk, njs_lexer_token_t, link));
     }
 }
 
@@ -253,6 +253,7 @@ typedef struct {
 typedef struct {
     njs_lexer_token_t               *token;
     njs_queue_t                     preread; /*  of njs_lexer_token_t */
+    njs_queue_t                     free;    /*  of njs_lexer_token_t */
 
     u_char                          *prev_start;
     njs_token_type_t                prev_type:16;
@@ -284,6 +285,7 @@ njs_lexer_token_t *njs_lexer_token(njs_lexer_t *lexer,
 njs_lexer_token_t *njs_lexer_peek_token(njs_lexer_t *lexer,
     njs_lexer_token_t *current, njs_bool_t with_end_line);
 void njs_lexer_consume_token(njs_lexer_t *lexer, unsigned length);
+void njs_lexer_tokens_free(njs_lexer_t *lexer);
 njs_int_t njs_lexer_make_token(njs_lexer_t *lexer, njs_lexer_token_t *token);
 njs_int_t njs_lexer_in_stack_init(njs_lexer_t *lexer);
 njs_int_t njs_lexer_in_stack_push(njs_lexer_t *lexer);
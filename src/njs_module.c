@@ -111,7 +111,7 @@ njs_module_add(njs_vm_t *vm, njs_str_t *name, njs_value_t *value)
 
     ret = njs_lvlhsh_insert(&vm->shared->modules_hash, &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert failed");
+        njs_hash_insert_error(vm, ret);
         return NULL;
     }
 
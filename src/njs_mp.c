@@ -15,9 +15,10 @@
  * can be divided on chunks of equal size.  Chunk size must be a power of 2.
  * A cluster can contains pages with different chunk sizes.  Cluster size
  * must be a multiple of page size and may be not a power of 2.  Allocations
- * greater than page are allocated outside clusters.  Start addresses and
- * sizes of the clusters and large allocations are stored in rbtree blocks
- * to find them on free operations.  The rbtree nodes are sorted by start
+ * greater than page are allocated outside clusters.  Clusters are stored
+ * in a hash by start addresses shifted by mp->cluster_shift, so a cluster
+ * of a freed chunk is found in one of two adjacent buckets.  Start addresses
+ * and sizes of large allocations are stored in rbtree blocks sorted by start
  * addresses.
  */
 
@@ -67,7 +68,9 @@ typedef enum {
 } njs_mp_block_type_t;
 
 
-typedef struct {
+typedef struct njs_mp_block_s  njs_mp_block_t;
+
+struct njs_mp_block_s {
     NJS_RBTREE_NODE             (node);
     njs_mp_block_type_t         type:8;
 
@@ -75,8 +78,12 @@ typedef struct {
     uint32_t                    size;
 
     u_char                      *start;
+
+    /* Next cluster in the same mp->clusters hash bucket. */
+    njs_mp_block_t              *next;
+
     njs_mp_page_t               pages[];
-} njs_mp_block_t;
+};
 
 
 typedef struct {
@@ -95,13 +102,33 @@ typedef struct {
 
 
 struct njs_mp_s {
-    /* rbtree of njs_mp_block_t. */
+    /* rbtree of large allocation njs_mp_block_t. */
     njs_rbtree_t                blocks;
 
+    /* Hash of cluster njs_mp_block_t, nbuckets is a power of 2. */
+    njs_mp_block_t              **clusters;
+    uint32_t                    nbuckets;
+    uint32_t                    nclusters;
+
     njs_queue_t                 free_pages;
 
+    /* Bump allocation region of small chunks, see njs_mp_nursery(). */
+    u_char                      *nursery_start;
+    u_char                      *nursery_pos;
+    u_char                      *nursery_end;
+
+    /*
+     * Total size of clusters, large allocations and the nursery,
+     * and its limits, see njs_mp_limit().  Zero means no limit.
+     */
+    size_t                      size;
+    size_t                      soft_limit;
+    size_t                      limit;
+    uint8_t                     limit_reached;   /* 1 bit */
+
     uint8_t                     chunk_size_shift;
     uint8_t                     page_size_shift;
+    uint8_t                     cluster_shift;
     uint32_t                    page_size;
     uint32_t                    page_alignment;
     uint32_t                    cluster_size;
@@ -129,12 +156,17 @@ struct njs_mp_s {
 
 
 static njs_uint_t njs_mp_shift(njs_uint_t n);
+static njs_bool_t njs_mp_limit_exceeded(njs_mp_t *mp, size_t size);
 #if !(NJS_DEBUG_MEMORY)
+njs_inline void *njs_mp_nursery_alloc(njs_mp_t *mp, size_t alignment,
+    size_t size);
 static void *njs_mp_alloc_small(njs_mp_t *mp, size_t size);
 static njs_uint_t njs_mp_alloc_chunk(u_char *map, njs_uint_t size);
 static njs_mp_page_t *njs_mp_alloc_page(njs_mp_t *mp);
 static njs_mp_block_t *njs_mp_alloc_cluster(njs_mp_t *mp);
+static njs_int_t njs_mp_clusters_grow(njs_mp_t *mp);
 #endif
+static njs_mp_block_t *njs_mp_find_cluster(njs_mp_t *mp, u_char *p);
 static void *njs_mp_alloc_large(njs_mp_t *mp, size_t alignment, size_t size);
 static intptr_t njs_mp_rbtree_compare(njs_rbtree_node_t *node1,
     njs_rbtree_node_t *node2);
@@ -213,6 +245,11 @@ njs_mp_fast_create(size_t cluster_size, size_t page_alignment, size_t page_size,
 
         mp->chunk_size_shift = njs_mp_shift(min_chunk_size);
         mp->page_size_shift = njs_mp_shift(page_size);
+        mp->cluster_shift = njs_mp_shift(cluster_size);
+
+        if (!njs_is_power_of_two(cluster_size)) {
+            mp->cluster_shift++;
+        }
 
         njs_rbtree_init(&mp->blocks, njs_mp_rbtree_compare);
 
@@ -240,10 +277,79 @@ njs_mp_shift(njs_uint_t n)
 }
 
 
+njs_int_t
+njs_mp_nursery(njs_mp_t *mp, size_t size)
+{
+#if !(NJS_DEBUG_MEMORY)
+
+    u_char  *p;
+
+    p = njs_memalign(mp->page_alignment, size);
+    if (njs_slow_path(p == NULL)) {
+        return NJS_ERROR;
+    }
+
+    if (mp->nursery_start != NULL) {
+        mp->size -= mp->nursery_end - mp->nursery_start;
+        njs_free(mp->nursery_start);
+    }
+
+    mp->nursery_start = p;
+    mp->nursery_pos = p;
+    mp->nursery_end = p + size;
+    mp->size += size;
+
+#endif
+
+    return NJS_OK;
+}
+
+
+void
+njs_mp_limit(njs_mp_t *mp, size_t soft, size_t hard)
+{
+    if (hard != 0) {
+        if (soft == 0) {
+            soft = hard - hard / 5;
+
+        } else if (soft > hard) {
+            soft = hard;
+        }
+    }
+
+    mp->soft_limit = soft;
+    mp->limit = hard;
+    mp->limit_reached = 0;
+}
+
+
+static njs_bool_t
+njs_mp_limit_exceeded(njs_mp_t *mp, size_t size)
+{
+    size_t  limit;
+
+    limit = mp->limit_reached ? mp->limit : mp->soft_limit;
+
+    if (limit == 0 || mp->size + size <= limit) {
+        return 0;
+    }
+
+    /*
+     * The first failure releases the memory up to the hard limit,
+     * so the error can still be thrown and handled.
+     */
+
+    mp->limit_reached = 1;
+
+    return 1;
+}
+
+
 njs_bool_t
 njs_mp_is_empty(njs_mp_t *mp)
 {
     return (njs_rbtree_is_empty(&mp->blocks)
+            && mp->nclusters == 0
             && njs_queue_is_empty(&mp->free_pages));
 }
 
@@ -252,7 +358,8 @@ void
 njs_mp_destroy(njs_mp_t *mp)
 {
     void               *p;
-    njs_mp_block_t     *block;
+    njs_uint_t         i;
+    njs_mp_block_t     *block, *cluster;
     njs_mp_cleanup_t   *c;
     njs_rbtree_node_t  *node, *next;
 
@@ -281,21 +388,113 @@ njs_mp_destroy(njs_mp_t *mp)
         njs_free(p);
     }
 
+    for (i = 0; i < mp->nbuckets; i++) {
+        cluster = mp->clusters[i];
+
+        while (cluster != NULL) {
+            block = cluster;
+            cluster = cluster->next;
+
+            njs_free(block->start);
+            njs_free(block);
+        }
+    }
+
+    njs_free(mp->clusters);
+    njs_free(mp->nursery_start);
     njs_free(mp);
 }
 
 
+/*
+ * Frees all memory allocated from the pool while keeping its clusters,
+ * so the pool can be reused without returning pages to the system.
+ */
+
+void
+njs_mp_reset(njs_mp_t *mp)
+{
+    void               *p;
+    njs_uint_t         i, n;
+    njs_mp_slot_t      *slot;
+    njs_mp_block_t     *block;
+    njs_mp_cleanup_t   *c;
+    njs_rbtree_node_t  *node, *next;
+
+    njs_debug_alloc("mp reset\n");
+
+    for (c = mp->cleanup; c != NULL; c = c->next) {
+        if (c->handler != NULL) {
+            njs_debug_alloc("mp run cleanup: @%p\n", c);
+            c->handler(c->data);
+        }
+    }
+
+    mp->cleanup = NULL;
+
+    for (slot = mp->slots; slot->size < mp->page_size / 2; slot++) {
+        njs_queue_init(&slot->pages);
+    }
+
+    njs_queue_init(&slot->pages);
+
+    njs_queue_init(&mp->free_pages);
+
+    mp->nursery_pos = mp->nursery_start;
+    mp->size = (mp->nursery_end - mp->nursery_start)
+               + mp->nclusters * mp->cluster_size;
+    mp->limit_reached = 0;
+
+    for (i = 0; i < mp->nbuckets; i++) {
+
+        for (block = mp->clusters[i]; block != NULL; block = block->next) {
+            n = mp->cluster_size >> mp->page_size_shift;
+
+            do {
+                n--;
+                block->pages[n].size = 0;
+                njs_queue_insert_head(&mp->free_pages, &block->pages[n].link);
+            } while (n != 0);
+        }
+    }
+
+    node = njs_rbtree_min(&mp->blocks);
+
+    while (njs_rbtree_is_there_successor(&mp->blocks, node)) {
+        next = njs_rbtree_node_successor(&mp->blocks, node);
+        block = (njs_mp_block_t *) node;
+
+        njs_rbtree_delete(&mp->blocks, &block->node);
+
+        p = block->start;
+
+        if (block->type == NJS_MP_DISCRETE_BLOCK) {
+            njs_free(block);
+        }
+
+        njs_free(p);
+
+        node = next;
+    }
+}
+
+
 void
 njs_mp_stat(njs_mp_t *mp, njs_mp_stat_t *stat)
 {
     njs_mp_block_t     *block;
     njs_rbtree_node_t  *node;
 
-    stat->size = 0;
-    stat->nblocks = 0;
+    stat->size = mp->nclusters * mp->cluster_size;
+    stat->nblocks = mp->nclusters;
     stat->cluster_size = mp->cluster_size;
     stat->page_size = mp->page_size;
 
+    if (mp->nursery_start != NULL) {
+        stat->nblocks++;
+        stat->size += mp->nursery_end - mp->nursery_start;
+    }
+
     node = njs_rbtree_min(&mp->blocks);
 
     while (njs_rbtree_is_there_successor(&mp->blocks, node)) {
@@ -312,11 +511,24 @@ njs_mp_stat(njs_mp_t *mp, njs_mp_stat_t *stat)
 void *
 njs_mp_alloc(njs_mp_t *mp, size_t size)
 {
+#if !(NJS_DEBUG_MEMORY)
+    void  *p;
+#endif
+
     njs_debug_alloc("mp alloc: %uz\n", size);
 
 #if !(NJS_DEBUG_MEMORY)
 
     if (size <= mp->page_size) {
+
+        if (mp->nursery_start != NULL) {
+            p = njs_mp_nursery_alloc(mp, NJS_MAX_ALIGNMENT, size);
+
+            if (njs_fast_path(p != NULL)) {
+                return p;
+            }
+        }
+
         return njs_mp_alloc_small(mp, size);
     }
 
@@ -344,6 +556,10 @@ njs_mp_zalloc(njs_mp_t *mp, size_t size)
 void *
 njs_mp_align(njs_mp_t *mp, size_t alignment, size_t size)
 {
+#if !(NJS_DEBUG_MEMORY)
+    void  *p;
+#endif
+
     njs_debug_alloc("mp align: @%uz:%uz\n", alignment, size);
 
     /* Alignment must be a power of 2. */
@@ -353,6 +569,15 @@ njs_mp_align(njs_mp_t *mp, size_t alignment, size_t size)
 #if !(NJS_DEBUG_MEMORY)
 
         if (size <= mp->page_size && alignment <= mp->page_alignment) {
+
+            if (mp->nursery_start != NULL) {
+                p = njs_mp_nursery_alloc(mp, alignment, size);
+
+                if (njs_fast_path(p != NULL)) {
+                    return p;
+                }
+            }
+
             size = njs_max(size, alignment);
 
             if (size <= mp->page_size) {
@@ -386,6 +611,25 @@ njs_mp_zalign(njs_mp_t *mp, size_t alignment, size_t size)
 
 #if !(NJS_DEBUG_MEMORY)
 
+njs_inline void *
+njs_mp_nursery_alloc(njs_mp_t *mp, size_t alignment, size_t size)
+{
+    u_char  *p;
+
+    p = njs_align_ptr(mp->nursery_pos, alignment);
+
+    if (njs_slow_path(p + size > mp->nursery_end)) {
+        return NULL;
+    }
+
+    mp->nursery_pos = p + size;
+
+    njs_debug_alloc("mp nursery alloc: %p\n", p);
+
+    return p;
+}
+
+
 njs_inline u_char *
 njs_mp_page_addr(njs_mp_t *mp, njs_mp_page_t *page)
 {
@@ -540,7 +784,11 @@ static njs_mp_block_t *
 njs_mp_alloc_cluster(njs_mp_t *mp)
 {
     njs_uint_t      n;
-    njs_mp_block_t  *cluster;
+    njs_mp_block_t  *cluster, **bucket;
+
+    if (njs_slow_path(njs_mp_limit_exceeded(mp, mp->cluster_size))) {
+        return NULL;
+    }
 
     n = mp->cluster_size >> mp->page_size_shift;
 
@@ -554,6 +802,13 @@ njs_mp_alloc_cluster(njs_mp_t *mp)
 
     cluster->size = mp->cluster_size;
 
+    if (mp->nclusters == mp->nbuckets) {
+        if (njs_slow_path(njs_mp_clusters_grow(mp) != NJS_OK)) {
+            njs_free(cluster);
+            return NULL;
+        }
+    }
+
     cluster->start = njs_memalign(mp->page_alignment, mp->cluster_size);
     if (njs_slow_path(cluster->start == NULL)) {
         njs_free(cluster);
@@ -571,11 +826,53 @@ njs_mp_alloc_cluster(njs_mp_t *mp)
                                 &cluster->pages[n].link);
     }
 
-    njs_rbtree_insert(&mp->blocks, &cluster->node);
+    bucket = &mp->clusters[((uintptr_t) cluster->start >> mp->cluster_shift)
+                           & (mp->nbuckets - 1)];
+
+    cluster->next = *bucket;
+    *bucket = cluster;
+
+    mp->nclusters++;
+    mp->size += mp->cluster_size;
 
     return cluster;
 }
 
+
+static njs_int_t
+njs_mp_clusters_grow(njs_mp_t *mp)
+{
+    uint32_t        n, nbuckets;
+    njs_mp_block_t  *cluster, *next, **clusters, **bucket;
+
+    nbuckets = (mp->nbuckets != 0) ? mp->nbuckets * 2 : 16;
+
+    clusters = njs_zalloc(nbuckets * sizeof(njs_mp_block_t *));
+    if (njs_slow_path(clusters == NULL)) {
+        return NJS_ERROR;
+    }
+
+    for (n = 0; n < mp->nbuckets; n++) {
+
+        for (cluster = mp->clusters[n]; cluster != NULL; cluster = next) {
+            next = cluster->next;
+
+            bucket = &clusters[((uintptr_t) cluster->start >> mp->cluster_shift)
+                               & (nbuckets - 1)];
+
+            cluster->next = *bucket;
+            *bucket = cluster;
+        }
+    }
+
+    njs_free(mp->clusters);
+
+    mp->clusters = clusters;
+    mp->nbuckets = nbuckets;
+
+    return NJS_OK;
+}
+
 #endif
 
 
@@ -600,6 +897,10 @@ njs_mp_alloc_large(njs_mp_t *mp, size_t alignment, size_t size)
     size += size == 0;
 #endif
 
+    if (njs_slow_path(njs_mp_limit_exceeded(mp, size))) {
+        return NULL;
+    }
+
     if (njs_is_power_of_two(size)) {
         block = njs_malloc(sizeof(njs_mp_block_t));
         if (njs_slow_path(block == NULL)) {
@@ -632,6 +933,8 @@ njs_mp_alloc_large(njs_mp_t *mp, size_t alignment, size_t size)
 
     njs_rbtree_insert(&mp->blocks, &block->node);
 
+    mp->size += size;
+
     return p;
 }
 
@@ -687,20 +990,34 @@ njs_mp_free(njs_mp_t *mp, void *p)
 
     njs_debug_alloc("mp free: @%p\n", p);
 
-    block = njs_mp_find_block(&mp->blocks, p);
+    if ((u_char *) p >= mp->nursery_start && (u_char *) p < mp->nursery_end) {
+        /* Nursery chunks are released all at once. */
+        return;
+    }
+
+    block = njs_mp_find_cluster(mp, p);
 
     if (njs_fast_path(block != NULL)) {
+        err = njs_mp_chunk_free(mp, block, p);
 
-        if (block->type == NJS_MP_CLUSTER_BLOCK) {
-            err = njs_mp_chunk_free(mp, block, p);
+        if (njs_fast_path(err == NULL)) {
+            return;
+        }
 
-            if (njs_fast_path(err == NULL)) {
-                return;
-            }
+        njs_assert_msg(0, err, p);
+
+        return;
+    }
+
+    block = njs_mp_find_block(&mp->blocks, p);
 
-        } else if (njs_fast_path(p == block->start)) {
+    if (njs_fast_path(block != NULL)) {
+
+        if (njs_fast_path(p == block->start)) {
             njs_rbtree_delete(&mp->blocks, &block->node);
 
+            mp->size -= block->size;
+
             if (block->type == NJS_MP_DISCRETE_BLOCK) {
                 njs_free(block);
             }
@@ -719,6 +1036,47 @@ njs_mp_free(njs_mp_t *mp, void *p)
 }
 
 
+static njs_mp_block_t *
+njs_mp_find_cluster(njs_mp_t *mp, u_char *p)
+{
+    uintptr_t       key;
+    njs_mp_block_t  *cluster;
+
+    if (mp->nclusters == 0) {
+        return NULL;
+    }
+
+    /*
+     * Cluster size is not greater than 1 << mp->cluster_shift, so
+     * the cluster starts either in the same or in the previous bucket.
+     */
+
+    key = (uintptr_t) p >> mp->cluster_shift;
+
+    for (cluster = mp->clusters[key & (mp->nbuckets - 1)];
+         cluster != NULL;
+         cluster = cluster->next)
+    {
+        if (p >= cluster->start && p < cluster->start + cluster->size) {
+            return cluster;
+        }
+    }
+
+    key--;
+
+    for (cluster = mp->clusters[key & (mp->nbuckets - 1)];
+         cluster != NULL;
+         cluster = cluster->next)
+    {
+        if (p >= cluster->start && p < cluster->start + cluster->size) {
+            return cluster;
+        }
+    }
+
+    return NULL;
+}
+
+
 static njs_mp_block_t *
 njs_mp_find_block(njs_rbtree_t *tree, u_char *p)
 {
@@ -752,10 +1110,11 @@ njs_mp_chunk_free(njs_mp_t *mp, njs_mp_block_t *cluster,
     u_char *p)
 {
     u_char         *start;
-    uintptr_t      offset;
-    njs_uint_t     n, size, chunk;
-    njs_mp_page_t  *page;
-    njs_mp_slot_t  *slot;
+    uintptr_t       offset;
+    njs_uint_t      n, size, chunk;
+    njs_mp_page_t   *page;
+    njs_mp_slot_t   *slot;
+    njs_mp_block_t  **bucket;
 
     n = (p - cluster->start) >> mp->page_size_shift;
     start = cluster->start + (n << mp->page_size_shift);
@@ -845,7 +1204,16 @@ njs_mp_chunk_free(njs_mp_t *mp, njs_mp_block_t *cluster,
          n--;
     } while (n != 0);
 
-    njs_rbtree_delete(&mp->blocks, &cluster->node);
+    bucket = &mp->clusters[((uintptr_t) cluster->start >> mp->cluster_shift)
+                           & (mp->nbuckets - 1)];
+
+    while (*bucket != cluster) {
+        bucket = &(*bucket)->next;
+    }
+
+    *bucket = cluster->next;
+    mp->nclusters--;
+    mp->size -= mp->cluster_size;
 
     p = cluster->start;
 
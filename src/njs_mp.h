@@ -33,8 +33,24 @@ NJS_EXPORT njs_mp_t *njs_mp_create(size_t cluster_size, size_t page_alignment,
 NJS_EXPORT njs_mp_t * njs_mp_fast_create(size_t cluster_size,
     size_t page_alignment, size_t page_size, size_t min_chunk_size)
     NJS_MALLOC_LIKE;
+/*
+ * Serves small allocations linearly from a region of the specified size.
+ * Freeing of such allocations is a no-op, the region is reused only after
+ * njs_mp_reset().  When the region is exhausted, small allocations are
+ * served from clusters again.
+ */
+NJS_EXPORT njs_int_t njs_mp_nursery(njs_mp_t *mp, size_t size);
+/*
+ * Limits the memory obtained by the pool from the system, zero means
+ * no limit.  Allocations fail beyond the soft limit.  After the first
+ * such failure allocations fail only beyond the hard limit, so that
+ * the failure can be handled.  The soft limit defaults to 80% of the
+ * hard limit.
+ */
+NJS_EXPORT void njs_mp_limit(njs_mp_t *mp, size_t soft, size_t hard);
 NJS_EXPORT njs_bool_t njs_mp_is_empty(njs_mp_t *mp);
 NJS_EXPORT void njs_mp_destroy(njs_mp_t *mp);
+NJS_EXPORT void njs_mp_reset(njs_mp_t *mp);
 NJS_EXPORT void njs_mp_stat(njs_mp_t *mp, njs_mp_stat_t *stat);
 
 NJS_EXPORT void *njs_mp_alloc(njs_mp_t *mp, size_t size)
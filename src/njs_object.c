@@ -61,6 +61,73 @@ njs_object_alloc(njs_vm_t *vm)
 }
 
 
+/*
+ * njs_object_shape_alloc() creates an object with the properties of the
+ * shape initialized to undefined.  The properties are allocated as a single
+ * array and are added to the private hash in the order of the shape.
+ */
+
+njs_object_t *
+njs_object_shape_alloc(njs_vm_t *vm, const njs_object_shape_t *shape)
+{
+    uint32_t                      i;
+    njs_object_t                  *object;
+    njs_object_prop_t             *prop;
+    njs_lvlhsh_query_t            lhq;
+    const njs_object_shape_key_t  *key;
+
+    object = njs_object_alloc(vm);
+    if (njs_slow_path(object == NULL)) {
+        return NULL;
+    }
+
+    prop = njs_mp_align(vm->mem_pool, sizeof(njs_value_t),
+                        shape->nprops * sizeof(njs_object_prop_t));
+    if (njs_slow_path(prop == NULL)) {
+        goto memory_error;
+    }
+
+    lhq.proto = &njs_object_hash_proto;
+    lhq.pool = vm->mem_pool;
+
+    object->hash.slot = njs_flathsh_new_size(&lhq, shape->nprops);
+    if (njs_slow_path(object->hash.slot == NULL)) {
+        goto memory_error;
+    }
+
+    key = shape->keys;
+
+    for (i = 0; i < shape->nprops; i++) {
+        njs_value_assign(&prop->name, &key->name);
+        njs_set_undefined(njs_prop_value(prop));
+
+        prop->type = NJS_PROPERTY;
+        prop->enum_in_object_hash = 0;
+        prop->writable = 1;
+        prop->enumerable = 1;
+        prop->configurable = 1;
+
+        lhq.key_hash = key->hash;
+        lhq.value = prop;
+
+        /* The hash has room for all the properties of the shape. */
+
+        (void) njs_flathsh_add_elt(&object->hash, &lhq);
+
+        prop++;
+        key++;
+    }
+
+    return object;
+
+memory_error:
+
+    njs_memory_error(vm);
+
+    return NULL;
+}
+
+
 njs_object_t *
 njs_object_value_copy(njs_vm_t *vm, njs_value_t *value)
 {
@@ -148,7 +215,7 @@ njs_object_hash_create(njs_vm_t *vm, njs_lvlhsh_t *hash,
 
         ret = njs_lvlhsh_insert(hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             return NJS_ERROR;
         }
 
@@ -203,6 +270,12 @@ njs_object_hash_test(njs_lvlhsh_query_t *lhq, void *data)
         }
 
         start = name->long_string.data->start;
+
+        /* Constant keys are interned by the generator. */
+
+        if (start == lhq->key.start) {
+            return NJS_OK;
+        }
     }
 
     if (memcmp(start, lhq->key.start, lhq->key.length) == 0) {
@@ -1271,6 +1344,7 @@ njs_object_traverse(njs_vm_t *vm, njs_object_t *object, void *ctx,
         {
             ret = njs_traverse_visit(&visited, &value);
             if (njs_slow_path(ret != NJS_OK)) {
+                njs_memory_error(vm);
                 return NJS_ERROR;
             }
 
@@ -1482,7 +1556,7 @@ njs_object_get_own_property_descriptors(njs_vm_t *vm, njs_value_t *args,
 
         ret = njs_lvlhsh_insert(&descriptors->hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             goto done;
         }
     }
@@ -1962,7 +2036,7 @@ njs_property_prototype_create(njs_vm_t *vm, njs_lvlhsh_t *hash,
         return njs_prop_value(prop);
     }
 
-    njs_internal_error(vm, "lvlhsh insert failed");
+    njs_hash_insert_error(vm, ret);
 
     return NULL;
 }
@@ -2216,7 +2290,7 @@ njs_property_constructor_set(njs_vm_t *vm, njs_lvlhsh_t *hash,
         return njs_prop_value(prop);
     }
 
-    njs_internal_error(vm, "lvlhsh insert/replace failed");
+    njs_memory_error(vm);
 
     return NULL;
 }
@@ -44,6 +44,25 @@ struct njs_object_init_s {
 };
 
 
+/*
+ * A shape describes the leading properties with constant string keys of
+ * an object literal.  The shape is created by the generator and is shared
+ * by all objects created from the literal, their private hashes are built
+ * with the same layout using the precomputed key hashes.
+ */
+
+typedef struct {
+    njs_value_t                 name;
+    uint32_t                    hash;
+} njs_object_shape_key_t;
+
+
+struct njs_object_shape_s {
+    uint32_t                    nprops;
+    njs_object_shape_key_t      keys[];
+};
+
+
 typedef struct njs_traverse_s  njs_traverse_t;
 
 struct njs_traverse_s {
@@ -63,6 +82,8 @@ typedef njs_int_t (*njs_object_traverse_cb_t)(njs_vm_t *vm,
 
 
 njs_object_t *njs_object_alloc(njs_vm_t *vm);
+njs_object_t *njs_object_shape_alloc(njs_vm_t *vm,
+    const njs_object_shape_t *shape);
 njs_object_t *njs_object_value_copy(njs_vm_t *vm, njs_value_t *value);
 njs_object_value_t *njs_object_value_alloc(njs_vm_t *vm, njs_uint_t index,
     size_t extra,const njs_value_t *value);
@@ -111,6 +132,9 @@ njs_int_t njs_object_get_prototype_of(njs_vm_t *vm, njs_value_t *args,
 const char *njs_prop_type_string(njs_object_prop_type_t type);
 njs_int_t njs_object_prop_init(njs_vm_t *vm, const njs_object_init_t* init,
     const njs_object_prop_t *base, njs_value_t *value, njs_value_t *retval);
+njs_object_prop_t *njs_object_prop_cache_fill(njs_vm_t *vm,
+    njs_prop_cache_t *cache, njs_object_t *object, const njs_value_t *key,
+    uint32_t hash);
 
 
 njs_inline njs_bool_t
@@ -137,6 +161,54 @@ njs_is_generic_descriptor(njs_object_prop_t *prop)
 }
 
 
+/*
+ * Objects which can be looked up through a property cache: the own
+ * private hash of a such object is always checked first for string keys,
+ * functions are excluded because shared functions are copied on access.
+ */
+#define njs_object_prop_cacheable(value)                                      \
+    (njs_is_object(value) && !njs_is_function(value))
+
+
+njs_inline njs_object_prop_t *
+njs_object_prop_cache_find(njs_prop_cache_t *cache, njs_object_t *object,
+    const njs_value_t *key)
+{
+    njs_uint_t              i;
+    njs_object_prop_t       *prop;
+    njs_flathsh_elt_t       *elt;
+    njs_prop_cache_entry_t  *entry;
+
+    if (object->hash.slot == NULL) {
+        return NULL;
+    }
+
+    for (i = 0; i < NJS_PROP_CACHE_SIZE; i++) {
+        entry = &cache->entries[i];
+
+        elt = njs_flathsh_elt(&object->hash, entry->index);
+        if (elt == NULL
+            || elt->key_hash != entry->key_hash
+            || elt->value == NULL)
+        {
+            continue;
+        }
+
+        prop = elt->value;
+
+        if (prop->type == NJS_PROPERTY
+            && njs_is_data_descriptor(prop)
+            && njs_is_string(&prop->name)
+            && njs_string_eq(&prop->name, key))
+        {
+            return prop;
+        }
+    }
+
+    return NULL;
+}
+
+
 njs_inline void
 njs_object_property_key_set(njs_lvlhsh_query_t *lhq, const njs_value_t *key,
     uint32_t hash)
@@ -172,7 +172,7 @@ njs_object_property_add(njs_vm_t *vm, njs_value_t *object, njs_value_t *key,
 
     ret = njs_lvlhsh_insert(njs_object_hash(object), &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert failed");
+        njs_hash_insert_error(vm, ret);
         return NULL;
     }
 
@@ -359,7 +359,7 @@ set_prop:
 
             ret = njs_lvlhsh_insert(njs_object_hash(object), &pq.lhq);
             if (njs_slow_path(ret != NJS_OK)) {
-                njs_internal_error(vm, "lvlhsh insert failed");
+                njs_hash_insert_error(vm, ret);
                 return NJS_ERROR;
             }
         }
@@ -656,7 +656,7 @@ njs_prop_private_copy(njs_vm_t *vm, njs_property_query_t *pq,
 
     ret = njs_lvlhsh_insert(&proto->hash, &pq->lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert failed");
+        njs_hash_insert_error(vm, ret);
         return NJS_ERROR;
     }
 
@@ -945,7 +945,7 @@ njs_object_prop_descriptor(njs_vm_t *vm, njs_value_t *dest,
 
         ret = njs_lvlhsh_insert(&desc->hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             return NJS_ERROR;
         }
 
@@ -963,7 +963,7 @@ njs_object_prop_descriptor(njs_vm_t *vm, njs_value_t *dest,
 
         ret = njs_lvlhsh_insert(&desc->hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             return NJS_ERROR;
         }
 
@@ -986,7 +986,7 @@ njs_object_prop_descriptor(njs_vm_t *vm, njs_value_t *dest,
 
         ret = njs_lvlhsh_insert(&desc->hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             return NJS_ERROR;
         }
 
@@ -1007,7 +1007,7 @@ njs_object_prop_descriptor(njs_vm_t *vm, njs_value_t *dest,
 
         ret = njs_lvlhsh_insert(&desc->hash, &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert failed");
+            njs_hash_insert_error(vm, ret);
             return NJS_ERROR;
         }
     }
@@ -1026,7 +1026,7 @@ njs_object_prop_descriptor(njs_vm_t *vm, njs_value_t *dest,
 
     ret = njs_lvlhsh_insert(&desc->hash, &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert failed");
+        njs_hash_insert_error(vm, ret);
         return NJS_ERROR;
     }
 
@@ -1044,7 +1044,7 @@ njs_object_prop_descriptor(njs_vm_t *vm, njs_value_t *dest,
 
     ret = njs_lvlhsh_insert(&desc->hash, &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert failed");
+        njs_hash_insert_error(vm, ret);
         return NJS_ERROR;
     }
 
@@ -1122,7 +1122,57 @@ njs_object_prop_init(njs_vm_t *vm, const njs_object_init_t* init,
         return NJS_OK;
     }
 
-    njs_internal_error(vm, "lvlhsh insert failed");
+    njs_hash_insert_error(vm, ret);
 
     return NJS_ERROR;
 }
+
+
+/*
+ * njs_object_prop_cache_fill() looks up an own data property by a string
+ * key in the private hash of the object and remembers its position in the
+ * cache.  Sites which mostly miss, for example accessing properties
+ * from prototypes, stop filling the cache after NJS_PROP_CACHE_MISSES
+ * misses.
+ */
+
+njs_object_prop_t *
+njs_object_prop_cache_fill(njs_vm_t *vm, njs_prop_cache_t *cache,
+    njs_object_t *object, const njs_value_t *key, uint32_t hash)
+{
+    njs_object_prop_t       *prop;
+    njs_flathsh_elt_t       *elt;
+    njs_lvlhsh_query_t      lhq;
+    njs_prop_cache_entry_t  *entry;
+
+    if (cache->misses >= NJS_PROP_CACHE_MISSES) {
+        return NULL;
+    }
+
+    njs_object_property_init(&lhq, key, hash);
+
+    elt = njs_flathsh_find_elt(&object->hash, &lhq);
+    if (elt == NULL) {
+        goto miss;
+    }
+
+    prop = elt->value;
+
+    if (prop->type != NJS_PROPERTY || !njs_is_data_descriptor(prop)) {
+        goto miss;
+    }
+
+    entry = &cache->entries[cache->next];
+    cache->next = (cache->next + 1) % NJS_PROP_CACHE_SIZE;
+
+    entry->index = elt - njs_flathsh_elts(object->hash.slot);
+    entry->key_hash = elt->key_hash;
+
+    return prop;
+
+miss:
+
+    cache->misses++;
+
+    return NULL;
+}
@@ -150,6 +150,7 @@ static njs_int_t njs_parser_multiplicative_expression(njs_parser_t *parser,
     njs_lexer_token_t *token, njs_queue_link_t *current);
 static njs_int_t njs_parser_multiplicative_expression_match(
     njs_parser_t *parser, njs_lexer_token_t *token, njs_queue_link_t *current);
+static void njs_parser_number_fold(njs_parser_node_t *node);
 
 static njs_int_t njs_parser_additive_expression(njs_parser_t *parser,
     njs_lexer_token_t *token, njs_queue_link_t *current);
@@ -551,6 +552,7 @@ njs_parser(njs_vm_t *vm, njs_parser_t *parser)
 {
     njs_int_t                        ret;
     njs_str_t                        str;
+    njs_queue_link_t                 *link;
     njs_lexer_token_t                *token;
     const njs_lexer_keyword_entry_t  *keyword;
 
@@ -583,6 +585,7 @@ njs_parser(njs_vm_t *vm, njs_parser_t *parser)
     parser->undefined_id = (uintptr_t) keyword->value;
 
     njs_queue_init(&parser->stack);
+    njs_queue_init(&parser->stack_free);
 
     parser->target = NULL;
     njs_parser_next(parser, njs_parser_statement_list);
@@ -596,7 +599,8 @@ njs_parser(njs_vm_t *vm, njs_parser_t *parser)
     do {
         token = njs_lexer_token(parser->lexer, 0);
         if (njs_slow_path(token == NULL)) {
-            return NJS_ERROR;
+            parser->ret = NJS_ERROR;
+            break;
         }
 
         parser->ret = parser->state(parser, token,
@@ -604,6 +608,16 @@ njs_parser(njs_vm_t *vm, njs_parser_t *parser)
 
     } while (parser->ret != NJS_DONE && parser->ret != NJS_ERROR);
 
+    while (!njs_queue_is_empty(&parser->stack_free)) {
+        link = njs_queue_first(&parser->stack_free);
+        njs_queue_remove(link);
+
+        njs_mp_free(vm->mem_pool,
+                    njs_queue_link_data(link, njs_parser_stack_entry_t, link));
+    }
+
+    njs_lexer_tokens_free(parser->lexer);
+
     if (parser->ret != NJS_DONE) {
         return NJS_ERROR;
     }
@@ -3698,6 +3712,8 @@ njs_parser_multiplicative_expression_match(njs_parser_t *parser,
         parser->target->right = parser->node;
         parser->target->right->dest = parser->target;
         parser->node = parser->target;
+
+        njs_parser_number_fold(parser->node);
     }
 
     switch (token->type) {
@@ -3736,6 +3752,55 @@ njs_parser_multiplicative_expression_match(njs_parser_t *parser,
 }
 
 
+static void
+njs_parser_number_fold(njs_parser_node_t *node)
+{
+    double  num, left, right;
+
+    if (node->left->token_type != NJS_TOKEN_NUMBER
+        || node->right->token_type != NJS_TOKEN_NUMBER)
+    {
+        return;
+    }
+
+    /* Constant folding of arithmetic on numeric literals. */
+
+    left = njs_number(&node->left->u.value);
+    right = njs_number(&node->right->u.value);
+
+    switch (node->u.operation) {
+    case NJS_VMCODE_ADDITION:
+        num = left + right;
+        break;
+
+    case NJS_VMCODE_SUBTRACTION:
+        num = left - right;
+        break;
+
+    case NJS_VMCODE_MULTIPLICATION:
+        num = left * right;
+        break;
+
+    case NJS_VMCODE_DIVISION:
+        num = left / right;
+        break;
+
+    case NJS_VMCODE_REMAINDER:
+        num = fmod(left, right);
+        break;
+
+    default:
+        return;
+    }
+
+    node->token_type = NJS_TOKEN_NUMBER;
+    node->left = NULL;
+    node->right = NULL;
+
+    njs_set_number(&node->u.value, num);
+}
+
+
 /*
  * 12.8 Additive Operators.
  */
@@ -3761,6 +3826,8 @@ njs_parser_additive_expression_match(njs_parser_t *parser,
         parser->target->right = parser->node;
         parser->target->right->dest = parser->target;
         parser->node = parser->target;
+
+        njs_parser_number_fold(parser->node);
     }
 
     switch (token->type) {
@@ -71,6 +71,7 @@ typedef njs_int_t (*njs_parser_state_func_t)(njs_parser_t *parser,
 struct njs_parser_s {
     njs_parser_state_func_t         state;
     njs_queue_t                     stack;
+    njs_queue_t                     stack_free;
     njs_lexer_t                     lexer0;
     njs_lexer_t                     *lexer;
     njs_vm_t                        *vm;
@@ -304,7 +305,7 @@ njs_parser_stack_pop(njs_parser_t *parser)
 
     parser->target = entry->node;
 
-    njs_mp_free(parser->vm->mem_pool, entry);
+    njs_queue_insert_head(&parser->stack_free, link);
 
     return NJS_OK;
 }
@@ -332,12 +333,21 @@ njs_inline njs_int_t
 _njs_parser_after(njs_parser_t *parser, njs_queue_link_t *link, void *node,
     njs_bool_t is_optional, njs_parser_state_func_t state)
 {
+    njs_queue_link_t          *lnk;
     njs_parser_stack_entry_t  *entry;
 
-    entry = njs_mp_alloc(parser->vm->mem_pool,
-                         sizeof(njs_parser_stack_entry_t));
-    if (njs_slow_path(entry == NULL)) {
-        return NJS_ERROR;
+    if (!njs_queue_is_empty(&parser->stack_free)) {
+        lnk = njs_queue_first(&parser->stack_free);
+        njs_queue_remove(lnk);
+
+        entry = njs_queue_link_data(lnk, njs_parser_stack_entry_t, link);
+
+    } else {
+        entry = njs_mp_alloc(parser->vm->mem_pool,
+                             sizeof(njs_parser_stack_entry_t));
+        if (njs_slow_path(entry == NULL)) {
+            return NJS_ERROR;
+        }
     }
 
     entry->state = state;
@@ -463,8 +463,11 @@ njs_promise_trigger_reactions(njs_vm_t *vm, njs_value_t *value,
     {
         reaction = njs_queue_link_data(link, njs_promise_reaction_t, link);
 
-        function = njs_promise_create_function(vm,
-                                               sizeof(njs_promise_context_t));
+        function = njs_promise_create_function(vm, 0);
+        if (njs_slow_path(function == NULL)) {
+            return njs_value_arg(&njs_value_null);
+        }
+
         function->u.native = njs_promise_reaction_job;
 
         njs_set_data(&arguments[0], reaction, 0);
@@ -644,7 +647,7 @@ njs_promise_resolve_function(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
     arguments[1] = *resolution;
     arguments[2] = then;
 
-    function = njs_promise_create_function(vm, sizeof(njs_promise_context_t));
+    function = njs_promise_create_function(vm, 0);
     if (njs_slow_path(function == NULL)) {
         return NJS_ERROR;
     }
@@ -888,8 +891,11 @@ njs_promise_perform_then(njs_vm_t *vm, njs_value_t *value,
         njs_queue_insert_tail(&data->reject_queue, &rejected_reaction->link);
 
     } else {
-        function = njs_promise_create_function(vm,
-                                               sizeof(njs_promise_context_t));
+        function = njs_promise_create_function(vm, 0);
+        if (njs_slow_path(function == NULL)) {
+            return NJS_ERROR;
+        }
+
         function->u.native = njs_promise_reaction_job;
 
         if (data->state == NJS_PROMISE_REJECTED) {
@@ -21,6 +21,7 @@ static njs_int_t njs_regexp_prototype_source(njs_vm_t *vm, njs_value_t *args,
     njs_uint_t nargs, njs_index_t unused, njs_value_t *retval);
 static int njs_regexp_pattern_compile(njs_vm_t *vm, njs_regex_t *regex,
     u_char *source, size_t len, njs_regex_flags_t flags);
+static void njs_regexp_pattern_cleanup(void *data);
 static u_char *njs_regexp_compile_trace_handler(njs_trace_t *trace,
     njs_trace_data_t *td, u_char *start);
 static u_char *njs_regexp_match_trace_handler(njs_trace_t *trace,
@@ -28,6 +29,8 @@ static u_char *njs_regexp_match_trace_handler(njs_trace_t *trace,
 #define NJS_REGEXP_FLAG_TEST           1
 static njs_int_t njs_regexp_exec(njs_vm_t *vm, njs_value_t *r, njs_value_t *s,
     unsigned flags, njs_value_t *retval);
+static njs_regex_match_data_t *njs_regexp_match_data(njs_vm_t *vm,
+    njs_regex_t *regex);
 static njs_array_t *njs_regexp_exec_result(njs_vm_t *vm, njs_value_t *r,
     njs_utf8_t utf8, njs_string_prop_t *string, njs_regex_match_data_t *data);
 
@@ -58,6 +61,9 @@ njs_regexp_init(njs_vm_t *vm)
         return NJS_ERROR;
     }
 
+    vm->match_data = NULL;
+    vm->match_data_ncaptures = 0;
+
     return NJS_OK;
 }
 
@@ -270,6 +276,7 @@ njs_regexp_pattern_create(njs_vm_t *vm, u_char *start, size_t length,
     njs_bool_t            in;
     njs_uint_t            n;
     njs_regex_t           *regex;
+    njs_mp_cleanup_t      *cln;
     njs_regexp_group_t    *group;
     njs_regexp_pattern_t  *pattern;
 
@@ -378,6 +385,15 @@ njs_regexp_pattern_create(njs_vm_t *vm, u_char *start, size_t length,
         goto fail;
     }
 
+    cln = njs_mp_cleanup_add(vm->mem_pool, 0);
+    if (njs_slow_path(cln == NULL)) {
+        njs_memory_error(vm);
+        goto fail;
+    }
+
+    cln->handler = njs_regexp_pattern_cleanup;
+    cln->data = pattern;
+
     pattern->ngroups = njs_regex_named_captures(regex, NULL, 0);
 
     if (pattern->ngroups != 0) {
@@ -406,6 +422,8 @@ njs_regexp_pattern_create(njs_vm_t *vm, u_char *start, size_t length,
 
 fail:
 
+    njs_regexp_pattern_cleanup(pattern);
+
     njs_mp_free(vm->mem_pool, pattern);
     return NULL;
 
@@ -440,6 +458,21 @@ njs_regexp_pattern_compile(njs_vm_t *vm, njs_regex_t *regex, u_char *source,
 }
 
 
+static void
+njs_regexp_pattern_cleanup(void *data)
+{
+    njs_regexp_pattern_t  *pattern = data;
+
+    if (njs_regex_is_valid(&pattern->regex[0])) {
+        njs_regex_free(&pattern->regex[0]);
+    }
+
+    if (njs_regex_is_valid(&pattern->regex[1])) {
+        njs_regex_free(&pattern->regex[1]);
+    }
+}
+
+
 static u_char *
 njs_regexp_compile_trace_handler(njs_trace_t *trace, njs_trace_data_t *td,
     u_char *start)
@@ -488,7 +521,12 @@ njs_regexp_match_trace_handler(njs_trace_t *trace, njs_trace_data_t *td,
     trace = trace->next;
     p = trace->handler(trace, td, start);
 
-    njs_internal_error(vm, "%*s", p - start, start);
+    if (td->level == NJS_LEVEL_CRIT) {
+        njs_memory_error(vm);
+
+    } else {
+        njs_internal_error(vm, "%*s", p - start, start);
+    }
 
     return p;
 }
@@ -917,10 +955,8 @@ njs_regexp_builtin_exec(njs_vm_t *vm, njs_value_t *r, njs_value_t *s,
         goto not_found;
     }
 
-    match_data = njs_regex_match_data(&pattern->regex[type],
-                                      vm->regex_generic_ctx);
+    match_data = njs_regexp_match_data(vm, &pattern->regex[type]);
     if (njs_slow_path(match_data == NULL)) {
-        njs_memory_error(vm);
         return NJS_ERROR;
     }
 
@@ -956,21 +992,16 @@ njs_regexp_builtin_exec(njs_vm_t *vm, njs_value_t *r, njs_value_t *s,
                                          njs_value_arg(&njs_string_lindex),
                                          &value);
             if (njs_slow_path(ret != NJS_OK)) {
-                njs_regex_match_data_free(match_data, vm->regex_generic_ctx);
                 return NJS_ERROR;
             }
         }
 
         if (flags & NJS_REGEXP_FLAG_TEST) {
-            njs_regex_match_data_free(match_data, vm->regex_generic_ctx);
             njs_set_boolean(retval, 1);
             return NJS_OK;
         }
 
         result = njs_regexp_exec_result(vm, r, utf8, &string, match_data);
-
-        njs_regex_match_data_free(match_data, vm->regex_generic_ctx);
-
         if (njs_slow_path(result == NULL)) {
             return NJS_ERROR;
         }
@@ -979,8 +1010,6 @@ njs_regexp_builtin_exec(njs_vm_t *vm, njs_value_t *r, njs_value_t *s,
         return NJS_OK;
     }
 
-    njs_regex_match_data_free(match_data, vm->regex_generic_ctx);
-
     if (njs_slow_path(ret == NJS_ERROR)) {
         return NJS_ERROR;
     }
@@ -1008,6 +1037,37 @@ static njs_exotic_slots_t njs_regexp_prototype_exotic_slots = {
 };
 
 
+/*
+ * The match data is shared by all patterns of the VM and grows
+ * to the largest number of captures seen so far.  It is not kept in
+ * the pattern itself because patterns are shared between VM clones.
+ */
+static njs_regex_match_data_t *
+njs_regexp_match_data(njs_vm_t *vm, njs_regex_t *regex)
+{
+    njs_regex_match_data_t  *match_data;
+
+    if (njs_fast_path(regex->ncaptures <= vm->match_data_ncaptures)) {
+        return vm->match_data;
+    }
+
+    match_data = njs_regex_match_data(regex, vm->regex_generic_ctx);
+    if (njs_slow_path(match_data == NULL)) {
+        njs_memory_error(vm);
+        return NULL;
+    }
+
+    if (vm->match_data != NULL) {
+        njs_regex_match_data_free(vm->match_data, vm->regex_generic_ctx);
+    }
+
+    vm->match_data = match_data;
+    vm->match_data_ncaptures = regex->ncaptures;
+
+    return match_data;
+}
+
+
 static njs_array_t *
 njs_regexp_exec_result(njs_vm_t *vm, njs_value_t *r, njs_utf8_t utf8,
     njs_string_prop_t *string, njs_regex_match_data_t *match_data)
@@ -1159,7 +1219,7 @@ njs_regexp_exec_result(njs_vm_t *vm, njs_value_t *r, njs_utf8_t utf8,
 
 insert_fail:
 
-    njs_internal_error(vm, "lvlhsh insert failed");
+    njs_hash_insert_error(vm, ret);
 
 fail:
 
@@ -1386,6 +1446,7 @@ njs_regexp_prototype_symbol_replace(njs_vm_t *vm, njs_value_t *args,
     for ( ;; ) {
         r = njs_arr_add(&results);
         if (njs_slow_path(r == NULL)) {
+            njs_memory_error(vm);
             ret = NJS_ERROR;
             goto exception;
         }
@@ -118,6 +118,24 @@ njs_scope_value_get(njs_vm_t *vm, njs_index_t index)
 }
 
 
+/*
+ * Replaces a long string value with the equal one from the values hash
+ * of the shared VM or of the VM, adding it to the latter if not found.
+ */
+
+njs_int_t
+njs_scope_string_intern(njs_vm_t *vm, njs_value_t *value)
+{
+    njs_index_t  *index;
+
+    if (njs_slow_path(njs_scope_value_index(vm, value, 1, &index) == NULL)) {
+        return NJS_ERROR;
+    }
+
+    return NJS_OK;
+}
+
+
 static njs_int_t
 njs_scope_values_hash_test(njs_lvlhsh_query_t *lhq, void *data)
 {
@@ -235,6 +253,7 @@ njs_scope_value_index(njs_vm_t *vm, const njs_value_t *src, njs_uint_t runtime,
 
             string->start = (u_char *) string + sizeof(njs_string_t);
             string->length = src->long_string.data->length;
+            string->buffer = 0;
 
             memcpy(string->start, start, size);
         }
@@ -35,3 +35,45 @@ njs_strncasecmp(u_char *s1, u_char *s2, size_t n)
 
     return 0;
 }
+
+
+/*
+ * Finds the first occurrence of s in [p, last).  Candidates are located
+ * by the first byte with memchr(), which is vectorized by libc.
+ */
+
+u_char *
+njs_strlstr(const u_char *p, const u_char *last, const u_char *s, size_t n)
+{
+    u_char        c;
+    const u_char  *end;
+
+    if (n == 0) {
+        return (u_char *) p;
+    }
+
+    if ((size_t) (last - p) < n) {
+        return NULL;
+    }
+
+    c = *s++;
+    n--;
+
+    end = last - n;
+
+    while (p < end) {
+        p = memchr(p, c, end - p);
+
+        if (p == NULL) {
+            return NULL;
+        }
+
+        if (memcmp(p + 1, s, n) == 0) {
+            return (u_char *) p;
+        }
+
+        p++;
+    }
+
+    return NULL;
+}
@@ -140,6 +140,8 @@ njs_strstr_case_eq(s1, s2)                                                    \
 
 
 NJS_EXPORT njs_int_t njs_strncasecmp(u_char *s1, u_char *s2, size_t n);
+NJS_EXPORT u_char *njs_strlstr(const u_char *p, const u_char *last,
+    const u_char *s, size_t n);
 
 
 #endif /* _NJS_STR_H_INCLUDED_ */
@@ -120,6 +120,7 @@ njs_string_set(njs_vm_t *vm, njs_value_t *value, const u_char *start,
 
         string->start = (u_char *) start;
         string->length = 0;
+        string->buffer = 0;
     }
 
     return NJS_OK;
@@ -136,11 +137,7 @@ njs_string_create(njs_vm_t *vm, njs_value_t *value, const u_char *src,
     p = (u_char *) src;
     p_end = p + size;
 
-    while (p < p_end && *p < 0x80) {
-          p++;
-    }
-
-    if (p == p_end) {
+    if (njs_utf8_ascii_skip(p, p_end) == p_end) {
         return njs_string_new(vm, value, (u_char *) src, size, size);
     }
 
@@ -151,6 +148,104 @@ njs_string_create(njs_vm_t *vm, njs_value_t *value, const u_char *src,
 }
 
 
+/*
+ * Creates a string referencing the source data without copying.
+ * The data must stay valid and unchanged as long as the VM.  Short
+ * strings, invalid UTF-8 and UTF-8 strings requiring the offset map
+ * are copied.  njs_string_set() marks the string as external.
+ */
+
+njs_int_t
+njs_string_create_external(njs_vm_t *vm, njs_value_t *value,
+    const u_char *src, size_t size)
+{
+    ssize_t    length;
+    njs_int_t  ret;
+
+    if (size <= NJS_STRING_SHORT || size > NJS_STRING_MAX_LENGTH) {
+        return njs_string_create(vm, value, src, size);
+    }
+
+    if (njs_utf8_ascii_skip(src, src + size) == src + size) {
+        length = size;
+
+    } else {
+        length = njs_utf8_length(src, size);
+
+        if (length < 0 || length > NJS_STRING_MAP_STRIDE) {
+            return njs_string_create(vm, value, src, size);
+        }
+    }
+
+    ret = njs_string_set(vm, value, src, size);
+    if (njs_slow_path(ret != NJS_OK)) {
+        return ret;
+    }
+
+    value->long_string.data->length = length;
+
+    return NJS_OK;
+}
+
+
+/*
+ * Medium-length strings created repeatedly by an embedder, such as header
+ * names and status texts, are looked up in the values hash first, which also
+ * contains the string constants of the compiled code.  A new string is
+ * added to the VM values hash, so the next one shares its njs_string_t.
+ */
+
+njs_int_t
+njs_string_intern(njs_vm_t *vm, njs_value_t *value, const u_char *src,
+    size_t size)
+{
+    ssize_t       length;
+    njs_int_t     ret;
+    njs_string_t  string;
+
+    if (size <= NJS_STRING_SHORT || size > NJS_STRING_INTERN_SIZE) {
+        return njs_string_create(vm, value, src, size);
+    }
+
+    if (njs_utf8_ascii_skip(src, src + size) == src + size) {
+        length = size;
+
+    } else {
+        length = njs_utf8_length(src, size);
+
+        if (length < 0 || length > NJS_STRING_MAP_STRIDE) {
+            return njs_string_create(vm, value, src, size);
+        }
+    }
+
+    string.start = (u_char *) src;
+    string.length = length;
+    string.buffer = 0;
+
+    value->type = NJS_STRING;
+    njs_string_truth(value, size);
+    value->short_string.size = NJS_STRING_LONG;
+    value->short_string.length = 0;
+    value->long_string.external = 0;
+    value->long_string.size = size;
+    value->long_string.data = &string;
+
+    ret = njs_scope_string_intern(vm, value);
+    if (njs_slow_path(ret != NJS_OK)) {
+        njs_memory_error(vm);
+        return NJS_ERROR;
+    }
+
+    if (njs_slow_path(!njs_is_string(value)
+                      || value->long_string.data->length != (size_t) length))
+    {
+        return njs_string_new(vm, value, src, size, length);
+    }
+
+    return NJS_OK;
+}
+
+
 njs_int_t
 njs_string_create_chb(njs_vm_t *vm, njs_value_t *value, njs_chb_t *chain)
 {
@@ -199,6 +294,46 @@ njs_string_new(njs_vm_t *vm, njs_value_t *value, const u_char *start,
 }
 
 
+/*
+ * Creates a string referencing a part of another long string without
+ * copying.  Strings requiring the UTF-8 offset map are copied, because
+ * the map is stored after the string data.
+ */
+
+njs_int_t
+njs_string_view(njs_vm_t *vm, njs_value_t *value, const u_char *start,
+    uint32_t size, uint32_t length)
+{
+    njs_string_t  *string;
+
+    if (size <= NJS_STRING_SHORT
+        || (size != length && length > NJS_STRING_MAP_STRIDE))
+    {
+        return njs_string_new(vm, value, start, size, length);
+    }
+
+    string = njs_mp_alloc(vm->mem_pool, sizeof(njs_string_t));
+    if (njs_slow_path(string == NULL)) {
+        njs_memory_error(vm);
+        return NJS_ERROR;
+    }
+
+    string->start = (u_char *) start;
+    string->length = length;
+    string->buffer = 0;
+
+    value->type = NJS_STRING;
+    njs_string_truth(value, size);
+    value->short_string.size = NJS_STRING_LONG;
+    value->short_string.length = 0;
+    value->long_string.external = 0;
+    value->long_string.size = size;
+    value->long_string.data = string;
+
+    return NJS_OK;
+}
+
+
 u_char *
 njs_string_alloc(njs_vm_t *vm, njs_value_t *value, uint64_t size,
     uint64_t length)
@@ -246,6 +381,7 @@ njs_string_alloc(njs_vm_t *vm, njs_value_t *value, uint64_t size,
 
         string->start = (u_char *) string + sizeof(njs_string_t);
         string->length = length;
+        string->buffer = 0;
 
         if (map_offset != 0) {
             map = (uint32_t *) (string->start + map_offset);
@@ -261,6 +397,80 @@ njs_string_alloc(njs_vm_t *vm, njs_value_t *value, uint64_t size,
 }
 
 
+/*
+ * Creates an ASCII string of the specified size starting with the ASCII
+ * string and returns the position after the copied string.  If the string
+ * is the longest one in its buffer and the buffer has enough capacity,
+ * the buffer is shared.  Otherwise a new buffer is allocated, with twice
+ * the size if the string was already in a buffer.
+ */
+
+u_char *
+njs_string_extend(njs_vm_t *vm, njs_value_t *value,
+    const njs_string_prop_t *string, njs_bool_t buffer, uint64_t size)
+{
+    uint64_t             capacity;
+    njs_string_t         *data;
+    njs_string_buffer_t  *buf;
+
+    if (njs_slow_path(size > NJS_STRING_MAX_LENGTH)) {
+        njs_range_error(vm, "invalid string length");
+        return NULL;
+    }
+
+    capacity = size;
+
+    if (buffer) {
+        buf = njs_string_buffer(string->start);
+
+        if (buf->size == string->size && buf->capacity >= size) {
+            data = njs_mp_alloc(vm->mem_pool, sizeof(njs_string_t));
+            if (njs_slow_path(data == NULL)) {
+                njs_memory_error(vm);
+                return NULL;
+            }
+
+            data->start = string->start;
+            buf->size = size;
+
+            goto done;
+        }
+
+        capacity = njs_min(size * 2, NJS_STRING_MAX_LENGTH);
+    }
+
+    data = njs_mp_alloc(vm->mem_pool, sizeof(njs_string_t)
+                                      + sizeof(njs_string_buffer_t) + capacity);
+    if (njs_slow_path(data == NULL)) {
+        njs_memory_error(vm);
+        return NULL;
+    }
+
+    buf = (njs_string_buffer_t *) ((u_char *) data + sizeof(njs_string_t));
+    buf->size = size;
+    buf->capacity = capacity;
+
+    data->start = (u_char *) buf + sizeof(njs_string_buffer_t);
+
+    memcpy(data->start, string->start, string->size);
+
+done:
+
+    data->length = size;
+    data->buffer = 1;
+
+    value->type = NJS_STRING;
+    njs_string_truth(value, size);
+    value->short_string.size = NJS_STRING_LONG;
+    value->short_string.length = 0;
+    value->long_string.external = 0;
+    value->long_string.size = size;
+    value->long_string.data = data;
+
+    return data->start + string->size;
+}
+
+
 uint32_t
 njs_string_length(njs_value_t *string)
 {
@@ -1202,7 +1412,7 @@ njs_string_slice(njs_vm_t *vm, njs_value_t *retval,
     njs_string_slice_string_prop(&prop, string, slice);
 
     if (njs_fast_path(prop.size != 0)) {
-        return njs_string_new(vm, retval, prop.start, prop.size, prop.length);
+        return njs_string_view(vm, retval, prop.start, prop.size, prop.length);
     }
 
     njs_value_assign(retval, &njs_string_empty);
@@ -1628,7 +1838,7 @@ njs_string_index_of(njs_string_prop_t *string, njs_string_prop_t *search,
     size_t from)
 {
     size_t        index, length, search_length;
-    const u_char  *p, *end;
+    const u_char  *p, *q, *end;
 
     length = string->length;
 
@@ -1645,14 +1855,10 @@ njs_string_index_of(njs_string_prop_t *string, njs_string_prop_t *search,
         if (string->size == length) {
             /* ASCII string. */
 
-            end -= (search->size - 1);
-
-            for (p = string->start + index; p < end; p++) {
-                if (memcmp(p, search->start, search->size) == 0) {
-                    return index;
-                }
-
-                index++;
+            q = njs_strlstr(string->start + index, end, search->start,
+                            search->size);
+            if (q != NULL) {
+                return q - string->start;
             }
 
         } else {
@@ -1661,15 +1867,21 @@ njs_string_index_of(njs_string_prop_t *string, njs_string_prop_t *search,
             p = (index < string->length)
                     ? njs_string_utf8_offset(string->start, end, index)
                     : end;
-            end -= search->size - 1;
 
             while (p < end) {
-                if (memcmp(p, search->start, search->size) == 0) {
-                    return index;
+                q = njs_strlstr(p, end, search->start, search->size);
+                if (q == NULL) {
+                    break;
                 }
 
-                index++;
-                p = njs_utf8_next(p, end);
+                while (p < q) {
+                    index++;
+                    p = njs_utf8_next(p, end);
+                }
+
+                if (p == q) {
+                    return index;
+                }
             }
         }
     }
@@ -1886,14 +2098,8 @@ njs_string_prototype_includes(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
             end = string.start + string.size;
             p = njs_string_offset(&string, index);
 
-            end -= search.size - 1;
-
-            while (p < end) {
-                if (memcmp(p, search.start, search.size) == 0) {
-                    return NJS_OK;
-                }
-
-                p++;
+            if (njs_strlstr(p, end, search.start, search.size) != NULL) {
+                return NJS_OK;
             }
         }
     }
@@ -2777,8 +2983,6 @@ njs_string_match_multiple(njs_vm_t *vm, njs_value_t *args,
                     break;
                 }
 
-                njs_internal_error(vm, "njs_regexp_match() failed");
-
                 return NJS_ERROR;
             }
 
@@ -2843,7 +3047,7 @@ njs_string_prototype_split(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
     njs_value_t        *this, *separator, *value;
     njs_value_t        separator_lvalue, limit_lvalue, splitter;
     njs_array_t        *array;
-    const u_char       *p, *start, *next, *last, *end;
+    const u_char       *p, *start, *next, *end;
     njs_string_prop_t  string, split;
     njs_value_t        arguments[3];
 
@@ -2932,19 +3136,14 @@ njs_string_prototype_split(njs_vm_t *vm, njs_value_t *args, njs_uint_t nargs,
 
     start = string.start;
     end = string.start + string.size;
-    last = end - split.size;
 
     do {
 
-        for (p = start; p <= last; p++) {
-            if (memcmp(p, split.start, split.size) == 0) {
-                goto found;
-            }
-        }
+        p = njs_strlstr(start, end, split.start, split.size);
 
-        p = end;
-
-found:
+        if (p == NULL) {
+            p = end;
+        }
 
         next = p + split.size;
 
@@ -2960,7 +3159,13 @@ found:
 
         len = njs_string_calc_length(utf8, start, size);
 
-        ret = njs_array_string_add(vm, array, start, size, len);
+        ret = njs_array_expand(vm, array, 0, 1);
+        if (njs_slow_path(ret != NJS_OK)) {
+            return ret;
+        }
+
+        ret = njs_string_view(vm, &array->start[array->length++], start, size,
+                              len);
         if (njs_slow_path(ret != NJS_OK)) {
             return ret;
         }
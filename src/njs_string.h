@@ -34,6 +34,9 @@
  */
 #define NJS_STRING_MAP_STRIDE  32
 
+/* The maximum size of strings interned by njs_string_intern(). */
+#define NJS_STRING_INTERN_SIZE  64
+
 #define njs_string_map_offset(size)  njs_align_size((size), sizeof(uint32_t))
 
 #define njs_string_map_start(p)                                               \
@@ -58,6 +61,13 @@
  * byte string just to be concatenated or to match regular expressions the
  * offset map is not required.
  *
+ * ASCII strings produced by concatenation are allocated in a buffer with
+ * spare capacity after the string data and without offset map.  The buffer
+ * size field is the size of the longest string using the buffer, so such
+ * a string can be extended in place while shorter strings sharing the data
+ * are not affected.  Repeated concatenation to the end of a string takes
+ * amortized linear time this way.
+ *
  * The map is not allocated:
  * 1) if string length is zero hence string is a byte string;
  * 2) if string size and length are equal so the string contains only
@@ -73,9 +83,20 @@
 struct njs_string_s {
     u_char    *start;
     uint32_t  length;   /* Length in UTF-8 characters. */
+    uint8_t   buffer;   /* The data is preceded by njs_string_buffer_t. */
 };
 
 
+typedef struct {
+    uint32_t  size;
+    uint32_t  capacity;
+} njs_string_buffer_t;
+
+
+#define njs_string_buffer(start)                                              \
+    ((njs_string_buffer_t *) (start) - 1)
+
+
 typedef struct {
     size_t    size;
     size_t    length;
@@ -107,10 +128,18 @@ njs_int_t njs_string_set(njs_vm_t *vm, njs_value_t *value, const u_char *start,
     uint32_t size);
 u_char *njs_string_alloc(njs_vm_t *vm, njs_value_t *value, uint64_t size,
     uint64_t length);
+u_char *njs_string_extend(njs_vm_t *vm, njs_value_t *value,
+    const njs_string_prop_t *string, njs_bool_t buffer, uint64_t size);
 njs_int_t njs_string_new(njs_vm_t *vm, njs_value_t *value, const u_char *start,
     uint32_t size, uint32_t length);
+njs_int_t njs_string_view(njs_vm_t *vm, njs_value_t *value, const u_char *start,
+    uint32_t size, uint32_t length);
 njs_int_t njs_string_create(njs_vm_t *vm, njs_value_t *value, const u_char *src,
     size_t size);
+njs_int_t njs_string_create_external(njs_vm_t *vm, njs_value_t *value,
+    const u_char *src, size_t size);
+njs_int_t njs_string_intern(njs_vm_t *vm, njs_value_t *value,
+    const u_char *src, size_t size);
 njs_int_t njs_string_create_chb(njs_vm_t *vm, njs_value_t *value,
     njs_chb_t *chain);
 
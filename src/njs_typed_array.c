@@ -1232,6 +1232,8 @@ njs_typed_array_prototype_iterator(njs_vm_t *vm, njs_value_t *args,
 
             r = njs_arr_add(&results);
             if (njs_slow_path(r == NULL)) {
+                njs_memory_error(vm);
+                ret = NJS_ERROR;
                 goto exception;
             }
 
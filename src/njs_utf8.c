@@ -218,9 +218,18 @@ u_char *
 njs_utf8_stream_encode(njs_unicode_decode_t *ctx, const u_char *start,
     const u_char *end, u_char *dst, njs_bool_t last, njs_bool_t fatal)
 {
-    uint32_t  cp;
+    uint32_t      cp;
+    const u_char  *ascii;
 
     while (start < end) {
+        if (ctx->need == 0x00 && *start < 0x80) {
+            ascii = njs_utf8_ascii_skip(start, end);
+            dst = njs_cpymem(dst, start, ascii - start);
+            start = ascii;
+
+            continue;
+        }
+
         cp = njs_utf8_decode(ctx, &start, end);
 
         if (cp > NJS_UNICODE_MAX_CODEPOINT) {
@@ -356,7 +365,7 @@ njs_utf8_stream_length(njs_unicode_decode_t *ctx, const u_char *p, size_t len,
 {
     size_t        size, length;
     uint32_t      codepoint;
-    const u_char  *end;
+    const u_char  *end, *ascii;
 
     size = 0;
     length = 0;
@@ -365,6 +374,16 @@ njs_utf8_stream_length(njs_unicode_decode_t *ctx, const u_char *p, size_t len,
         end = p + len;
 
         while (p < end) {
+            if (ctx->need == 0x00 && *p < 0x80) {
+                ascii = njs_utf8_ascii_skip(p, end);
+
+                size += ascii - p;
+                length += ascii - p;
+                p = ascii;
+
+                continue;
+            }
+
             codepoint = njs_utf8_decode(ctx, &p, end);
 
             if (codepoint > NJS_UNICODE_MAX_CODEPOINT) {
@@ -412,6 +431,11 @@ njs_utf8_is_valid(const u_char *p, size_t len)
     njs_utf8_decode_init(&ctx);
 
     while (p < end) {
+        if (*p < 0x80) {
+            p = njs_utf8_ascii_skip(p, end);
+            continue;
+        }
+
         if (njs_slow_path(njs_utf8_decode(&ctx, &p, end)
                           > NJS_UNICODE_MAX_CODEPOINT))
         {
@@ -421,3 +445,31 @@ njs_utf8_is_valid(const u_char *p, size_t len)
 
     return 1;
 }
+
+
+/*
+ * Returns a pointer to the first non-ASCII byte or to the end.
+ * The bytes are tested eight at a time while possible.
+ */
+
+const u_char *
+njs_utf8_ascii_skip(const u_char *p, const u_char *end)
+{
+    uint64_t  word;
+
+    while (end - p >= 8) {
+        memcpy(&word, p, 8);
+
+        if ((word & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+
+        p += 8;
+    }
+
+    while (p < end && *p < 0x80) {
+        p++;
+    }
+
+    return p;
+}
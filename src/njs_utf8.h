@@ -24,6 +24,8 @@ NJS_EXPORT ssize_t njs_utf8_stream_length(njs_unicode_decode_t *ctx,
     const u_char *p, size_t len, njs_bool_t last, njs_bool_t fatal,
     size_t *out_size);
 NJS_EXPORT njs_bool_t njs_utf8_is_valid(const u_char *p, size_t len);
+NJS_EXPORT const u_char *njs_utf8_ascii_skip(const u_char *p,
+    const u_char *end);
 
 
 njs_inline uint32_t
@@ -1056,6 +1056,19 @@ njs_external_property_query(njs_vm_t *vm, njs_property_query_t *pq,
 njs_int_t
 njs_value_property(njs_vm_t *vm, njs_value_t *value, njs_value_t *key,
     njs_value_t *retval)
+{
+    return njs_value_property_hash(vm, value, key, 0, retval);
+}
+
+
+/*
+ * njs_value_property_hash() is similar to njs_value_property(), but
+ * accepts the precomputed hash of a string key or zero.
+ */
+
+njs_int_t
+njs_value_property_hash(njs_vm_t *vm, njs_value_t *value, njs_value_t *key,
+    uint32_t hash, njs_value_t *retval)
 {
     double                num;
     uint32_t              index;
@@ -1116,7 +1129,7 @@ njs_value_property(njs_vm_t *vm, njs_value_t *value, njs_value_t *key,
 
 slow_path:
 
-    njs_property_query_init(&pq, NJS_PROPERTY_QUERY_GET, 0, 0);
+    njs_property_query_init(&pq, NJS_PROPERTY_QUERY_GET, hash, 0);
 
     ret = njs_property_query(vm, &pq, value, key);
 
@@ -1187,6 +1200,14 @@ slow_path:
 njs_int_t
 njs_value_property_set(njs_vm_t *vm, njs_value_t *value, njs_value_t *key,
     njs_value_t *setval)
+{
+    return njs_value_property_set_hash(vm, value, key, 0, setval);
+}
+
+
+njs_int_t
+njs_value_property_set_hash(njs_vm_t *vm, njs_value_t *value, njs_value_t *key,
+    uint32_t hash, njs_value_t *setval)
 {
     double                num;
     uint32_t              index;
@@ -1249,7 +1270,7 @@ slow_path:
         return NJS_ERROR;
     }
 
-    njs_property_query_init(&pq, NJS_PROPERTY_QUERY_SET, 0, 0);
+    njs_property_query_init(&pq, NJS_PROPERTY_QUERY_SET, hash, 0);
 
     ret = njs_property_query(vm, &pq, value, key);
 
@@ -1405,7 +1426,7 @@ slow_path:
 
     ret = njs_lvlhsh_insert(njs_object_hash(value), &pq.lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert failed");
+        njs_hash_insert_error(vm, ret);
         return NJS_ERROR;
     }
 
@@ -88,6 +88,7 @@ typedef struct njs_regexp_s           njs_regexp_t;
 typedef struct njs_date_s             njs_date_t;
 typedef struct njs_object_value_s     njs_promise_t;
 typedef struct njs_property_next_s    njs_property_next_t;
+typedef struct njs_object_shape_s     njs_object_shape_t;
 
 
 union njs_value_s {
@@ -390,6 +391,32 @@ typedef struct {
 } njs_property_query_t;
 
 
+/*
+ * A property cache of an instruction remembers the positions of own data
+ * properties in the private hashes of recently accessed objects.  Objects
+ * created from the same object literal share the layout of the hash, so an
+ * entry matches all of them.  An entry is validated against the element
+ * of the current hash of an object on every access, so the cache can be
+ * safely shared by cloned VMs.
+ */
+
+#define NJS_PROP_CACHE_SIZE     4
+#define NJS_PROP_CACHE_MISSES   16
+
+
+typedef struct {
+    uint32_t                    index;
+    uint32_t                    key_hash;
+} njs_prop_cache_entry_t;
+
+
+typedef struct {
+    njs_prop_cache_entry_t      entries[NJS_PROP_CACHE_SIZE];
+    uint8_t                     next;
+    uint8_t                     misses;
+} njs_prop_cache_t;
+
+
 #define njs_value(_type, _truth, _number) {                                   \
     .data = {                                                                 \
         .type = _type,                                                        \
@@ -1040,8 +1067,12 @@ njs_int_t njs_property_query(njs_vm_t *vm, njs_property_query_t *pq,
 
 njs_int_t njs_value_property(njs_vm_t *vm, njs_value_t *value,
     njs_value_t *key, njs_value_t *retval);
+njs_int_t njs_value_property_hash(njs_vm_t *vm, njs_value_t *value,
+    njs_value_t *key, uint32_t hash, njs_value_t *retval);
 njs_int_t njs_value_property_set(njs_vm_t *vm, njs_value_t *value,
     njs_value_t *key, njs_value_t *setval);
+njs_int_t njs_value_property_set_hash(njs_vm_t *vm, njs_value_t *value,
+    njs_value_t *key, uint32_t hash, njs_value_t *setval);
 njs_int_t njs_value_property_delete(njs_vm_t *vm, njs_value_t *value,
     njs_value_t *key, njs_value_t *removed, njs_bool_t thrw);
 njs_int_t njs_value_to_object(njs_vm_t *vm, njs_value_t *value);
@@ -8,7 +8,10 @@
 #include <njs_main.h>
 
 
-static njs_int_t njs_vm_protos_init(njs_vm_t *vm, njs_value_t *global);
+static njs_vm_t *njs_vm_clone_init(njs_vm_t *vm, njs_mp_t *nmp,
+    njs_external_ptr_t external);
+static njs_int_t njs_vm_protos_init(njs_vm_t *vm, njs_value_t *global,
+    void *start);
 
 
 const njs_str_t  njs_entry_empty =          njs_str("");
@@ -42,6 +45,8 @@ njs_vm_create(njs_vm_opt_t *options)
         return NULL;
     }
 
+    njs_mp_limit(mp, options->memory_soft_limit, options->memory_limit);
+
     vm = njs_mp_zalign(mp, sizeof(njs_value_t), sizeof(njs_vm_t));
     if (njs_slow_path(vm == NULL)) {
         return NULL;
@@ -108,7 +113,7 @@ njs_vm_create(njs_vm_opt_t *options)
         }
     }
 
-    ret = njs_vm_protos_init(vm, &vm->global_value);
+    ret = njs_vm_protos_init(vm, &vm->global_value, NULL);
     if (njs_slow_path(ret != NJS_OK)) {
         return NULL;
     }
@@ -381,10 +386,8 @@ njs_vm_compile_module(njs_vm_t *vm, njs_str_t *name, u_char **start,
 njs_vm_t *
 njs_vm_clone(njs_vm_t *vm, njs_external_ptr_t external)
 {
-    njs_mp_t     *nmp;
-    njs_vm_t     *nvm;
-    njs_int_t    ret;
-    njs_value_t  **global;
+    njs_mp_t  *nmp;
+    njs_vm_t  *nvm;
 
     njs_thread_log_debug("CLONE:");
 
@@ -397,9 +400,79 @@ njs_vm_clone(njs_vm_t *vm, njs_external_ptr_t external)
         return NULL;
     }
 
-    nvm = njs_mp_align(nmp, sizeof(njs_value_t), sizeof(njs_vm_t));
+    /*
+     * Most of the clone allocations live until the clone is destroyed,
+     * so small ones are served linearly from a nursery region.
+     */
+
+    if (njs_slow_path(njs_mp_nursery(nmp, NJS_VM_NURSERY_SIZE) != NJS_OK)) {
+        njs_mp_destroy(nmp);
+        return NULL;
+    }
+
+    njs_mp_limit(nmp, vm->options.memory_soft_limit, vm->options.memory_limit);
+
+    nvm = njs_vm_clone_init(vm, nmp, external);
     if (njs_slow_path(nvm == NULL)) {
-        goto fail;
+        njs_mp_destroy(nmp);
+        return NULL;
+    }
+
+    return nvm;
+}
+
+
+njs_vm_t *
+njs_vm_recycle(njs_vm_t *vm, njs_vm_t *clone, njs_external_ptr_t external)
+{
+    njs_mp_t  *nmp;
+    njs_vm_t  *nvm;
+
+    njs_thread_log_debug("RECYCLE:");
+
+    if (clone->hooks[NJS_HOOK_EXIT] != NULL) {
+        (void) njs_vm_call(clone, clone->hooks[NJS_HOOK_EXIT], NULL, 0);
+    }
+
+    nmp = clone->mem_pool;
+
+    if (vm->options.interactive) {
+        njs_mp_destroy(nmp);
+        return NULL;
+    }
+
+    njs_mp_reset(nmp);
+
+    nvm = njs_vm_clone_init(vm, nmp, external);
+    if (njs_slow_path(nvm == NULL)) {
+        njs_mp_destroy(nmp);
+        return NULL;
+    }
+
+    return nvm;
+}
+
+
+static njs_vm_t *
+njs_vm_clone_init(njs_vm_t *vm, njs_mp_t *nmp, njs_external_ptr_t external)
+{
+    size_t       size, vm_size;
+    njs_vm_t     *nvm;
+    njs_int_t    ret;
+    njs_value_t  **global;
+
+    /*
+     * The VM and its copies of the built-in constructors and prototypes
+     * are allocated as a single block to save a large allocation per clone.
+     */
+
+    vm_size = njs_align_size(sizeof(njs_vm_t), sizeof(njs_value_t));
+    size = vm->shared->constructors->items
+           * (sizeof(njs_function_t) + sizeof(njs_object_prototype_t));
+
+    nvm = njs_mp_align(nmp, sizeof(njs_value_t), vm_size + size);
+    if (njs_slow_path(nvm == NULL)) {
+        return NULL;
     }
 
     *nvm = *vm;
@@ -410,17 +483,18 @@ njs_vm_clone(njs_vm_t *vm, njs_external_ptr_t external)
 
     ret = njs_vm_runtime_init(nvm);
     if (njs_slow_path(ret != NJS_OK)) {
-        goto fail;
+        return NULL;
     }
 
-    ret = njs_vm_protos_init(nvm, &nvm->global_value);
+    ret = njs_vm_protos_init(nvm, &nvm->global_value,
+                             (u_char *) nvm + vm_size);
     if (njs_slow_path(ret != NJS_OK)) {
-        goto fail;
+        return NULL;
     }
 
     global = njs_scope_make(nvm, nvm->global_scope->items);
     if (njs_slow_path(global == NULL)) {
-        goto fail;
+        return NULL;
     }
 
     nvm->levels[NJS_LEVEL_GLOBAL] = global;
@@ -431,12 +505,6 @@ njs_vm_clone(njs_vm_t *vm, njs_external_ptr_t external)
     nvm->levels[NJS_LEVEL_LOCAL] = NULL;
 
     return nvm;
-
-fail:
-
-    njs_mp_destroy(nmp);
-
-    return NULL;
 }
 
 
@@ -539,7 +607,7 @@ njs_vm_constructors_init(njs_vm_t *vm)
 
 
 static njs_int_t
-njs_vm_protos_init(njs_vm_t *vm, njs_value_t *global)
+njs_vm_protos_init(njs_vm_t *vm, njs_value_t *global, void *start)
 {
     size_t  ctor_size, proto_size;
 
@@ -548,12 +616,16 @@ njs_vm_protos_init(njs_vm_t *vm, njs_value_t *global)
     ctor_size = vm->constructors_size * sizeof(njs_function_t);
     proto_size = vm->constructors_size * sizeof(njs_object_prototype_t);
 
-    vm->constructors = njs_mp_alloc(vm->mem_pool, ctor_size + proto_size);
-    if (njs_slow_path(vm->constructors == NULL)) {
-        njs_memory_error(vm);
-        return NJS_ERROR;
+    if (start == NULL) {
+        start = njs_mp_alloc(vm->mem_pool, ctor_size + proto_size);
+        if (njs_slow_path(start == NULL)) {
+            njs_memory_error(vm);
+            return NJS_ERROR;
+        }
     }
 
+    vm->constructors = start;
+
     vm->prototypes = (njs_object_prototype_t *)
                                      ((u_char *) vm->constructors + ctor_size);
 
@@ -630,24 +702,27 @@ njs_vm_enqueue_job(njs_vm_t *vm, njs_function_t *function,
 {
     njs_event_t  *event;
 
-    event = njs_mp_zalloc(vm->mem_pool, sizeof(njs_event_t));
+    /* The event and its arguments are freed after the job is executed. */
+
+    event = njs_mp_align(vm->mem_pool, sizeof(njs_value_t),
+                         njs_align_size(sizeof(njs_event_t),
+                                        sizeof(njs_value_t))
+                         + sizeof(njs_value_t) * nargs);
     if (njs_slow_path(event == NULL)) {
         njs_memory_error(vm);
         return NJS_ERROR;
     }
 
     event->function = function;
+    event->args = NULL;
+    event->nargs = nargs;
 
     if (nargs != 0) {
-        event->args = njs_mp_alloc(vm->mem_pool, sizeof(njs_value_t) * nargs);
-        if (njs_slow_path(event->args == NULL)) {
-            njs_memory_error(vm);
-            return NJS_ERROR;
-        }
+        event->args = (njs_value_t *) ((u_char *) event
+                                       + njs_align_size(sizeof(njs_event_t),
+                                                        sizeof(njs_value_t)));
 
         memcpy(event->args, args, sizeof(njs_value_t) * nargs);
-
-        event->nargs = nargs;
     }
 
     njs_queue_insert_tail(&vm->jobs, &event->link);
@@ -688,6 +763,9 @@ njs_vm_execute_pending_job(njs_vm_t *vm)
     njs_queue_remove(&ev->link);
 
     ret = njs_vm_call(vm, ev->function, ev->args, ev->nargs);
+
+    njs_mp_free(vm->mem_pool, ev);
+
     if (ret == NJS_ERROR) {
         return ret;
     }
@@ -747,6 +825,13 @@ njs_vm_external_ptr(njs_vm_t *vm)
 }
 
 
+void
+njs_vm_external_ptr_set(njs_vm_t *vm, njs_external_ptr_t external)
+{
+    vm->external = external;
+}
+
+
 njs_bool_t
 njs_vm_constructor(njs_vm_t *vm)
 {
@@ -891,7 +976,7 @@ njs_vm_bind2(njs_vm_t *vm, const njs_str_t *var_name, njs_object_prop_t *prop,
 
     ret = njs_lvlhsh_insert(hash, &lhq);
     if (njs_slow_path(ret != NJS_OK)) {
-        njs_internal_error(vm, "lvlhsh insert failed");
+        njs_hash_insert_error(vm, ret);
         return ret;
     }
 
@@ -981,6 +1066,22 @@ njs_vm_value_string_create(njs_vm_t *vm, njs_value_t *value,
 }
 
 
+njs_int_t
+njs_vm_value_string_intern(njs_vm_t *vm, njs_value_t *value,
+    const u_char *start, uint32_t size)
+{
+    return njs_string_intern(vm, value, start, size);
+}
+
+
+njs_int_t
+njs_vm_value_string_external(njs_vm_t *vm, njs_value_t *value,
+    const u_char *start, uint32_t size)
+{
+    return njs_string_create_external(vm, value, start, size);
+}
+
+
 njs_int_t
 njs_vm_value_string_create_chb(njs_vm_t *vm, njs_value_t *value,
     njs_chb_t *chain)
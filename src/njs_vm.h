@@ -9,6 +9,7 @@
 
 
 #define NJS_MAX_STACK_SIZE       (64 * 1024)
+#define NJS_VM_NURSERY_SIZE      (32 * 1024)
 
 
 typedef struct njs_frame_s            njs_frame_t;
@@ -158,6 +159,8 @@ struct njs_vm_s {
     njs_regex_generic_ctx_t  *regex_generic_ctx;
     njs_regex_compile_ctx_t  *regex_compile_ctx;
     njs_regex_match_data_t   *single_match_data;
+    njs_regex_match_data_t   *match_data;
+    njs_int_t                match_data_ncaptures;
 
     njs_parser_scope_t       *global_scope;
 
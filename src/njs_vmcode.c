@@ -13,7 +13,8 @@ struct njs_property_next_s {
     njs_array_t  *array;
 };
 
-static njs_jump_off_t njs_vmcode_object(njs_vm_t *vm, njs_value_t *retval);
+static njs_jump_off_t njs_vmcode_object(njs_vm_t *vm, u_char *pc,
+    njs_value_t *retval);
 static njs_jump_off_t njs_vmcode_array(njs_vm_t *vm, u_char *pc,
     njs_value_t *retval);
 static njs_jump_off_t njs_vmcode_function(njs_vm_t *vm, u_char *pc,
@@ -27,7 +28,7 @@ static njs_jump_off_t njs_vmcode_function_copy(njs_vm_t *vm, njs_value_t *value,
     njs_index_t retval);
 
 static njs_jump_off_t njs_vmcode_property_init(njs_vm_t *vm, njs_value_t *value,
-    njs_value_t *key, njs_value_t *retval);
+    njs_value_t *key, uint32_t hash, njs_value_t *retval);
 static njs_jump_off_t njs_vmcode_proto_init(njs_vm_t *vm, njs_value_t *value,
     njs_value_t *key, njs_value_t *retval);
 static njs_jump_off_t njs_vmcode_property_in(njs_vm_t *vm,
@@ -73,6 +74,104 @@ static njs_jump_off_t njs_function_frame_create(njs_vm_t *vm,
     njs_bool_t ctor);
 
 
+/* Instruction sizes, shared by the generator and the disassembler. */
+
+const uint8_t  njs_vmcode_size[NJS_VMCODES] = {
+    [NJS_VMCODE_PUT_ARG] = sizeof(njs_vmcode_1addr_t),
+    [NJS_VMCODE_STOP] = sizeof(njs_vmcode_stop_t),
+    [NJS_VMCODE_JUMP] = sizeof(njs_vmcode_jump_t),
+    [NJS_VMCODE_PROPERTY_SET] = sizeof(njs_vmcode_prop_set_t),
+    [NJS_VMCODE_PROPERTY_ACCESSOR] = sizeof(njs_vmcode_prop_accessor_t),
+    [NJS_VMCODE_IF_TRUE_JUMP] = sizeof(njs_vmcode_cond_jump_t),
+    [NJS_VMCODE_IF_FALSE_JUMP] = sizeof(njs_vmcode_cond_jump_t),
+    [NJS_VMCODE_IF_EQUAL_JUMP] = sizeof(njs_vmcode_equal_jump_t),
+    [NJS_VMCODE_PROPERTY_INIT] = sizeof(njs_vmcode_prop_set_t),
+    [NJS_VMCODE_RETURN] = sizeof(njs_vmcode_return_t),
+    [NJS_VMCODE_FUNCTION_COPY] = sizeof(njs_vmcode_function_copy_t),
+    [NJS_VMCODE_FUNCTION_FRAME] = sizeof(njs_vmcode_function_frame_t),
+    [NJS_VMCODE_METHOD_FRAME] = sizeof(njs_vmcode_method_frame_t),
+    [NJS_VMCODE_FUNCTION_CALL] = sizeof(njs_vmcode_function_call_t),
+    [NJS_VMCODE_PROPERTY_NEXT] = sizeof(njs_vmcode_prop_next_t),
+    [NJS_VMCODE_ARGUMENTS] = sizeof(njs_vmcode_arguments_t),
+    [NJS_VMCODE_PROTO_INIT] = sizeof(njs_vmcode_prop_set_t),
+    [NJS_VMCODE_TO_PROPERTY_KEY] = sizeof(njs_vmcode_2addr_t),
+    [NJS_VMCODE_TO_PROPERTY_KEY_CHK] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_SET_FUNCTION_NAME] = sizeof(njs_vmcode_2addr_t),
+    [NJS_VMCODE_IMPORT] = sizeof(njs_vmcode_import_t),
+    [NJS_VMCODE_AWAIT] = sizeof(njs_vmcode_await_t),
+    [NJS_VMCODE_TRY_START] = sizeof(njs_vmcode_try_start_t),
+    [NJS_VMCODE_THROW] = sizeof(njs_vmcode_throw_t),
+    [NJS_VMCODE_TRY_BREAK] = sizeof(njs_vmcode_try_trampoline_t),
+    [NJS_VMCODE_TRY_CONTINUE] = sizeof(njs_vmcode_try_trampoline_t),
+    [NJS_VMCODE_TRY_END] = sizeof(njs_vmcode_try_end_t),
+    [NJS_VMCODE_CATCH] = sizeof(njs_vmcode_catch_t),
+    [NJS_VMCODE_FINALLY] = sizeof(njs_vmcode_finally_t),
+    [NJS_VMCODE_LET] = sizeof(njs_vmcode_variable_t),
+    [NJS_VMCODE_LET_UPDATE] = sizeof(njs_vmcode_variable_t),
+    [NJS_VMCODE_INITIALIZATION_TEST] = sizeof(njs_vmcode_variable_t),
+    [NJS_VMCODE_NOT_INITIALIZED] = sizeof(njs_vmcode_variable_t),
+    [NJS_VMCODE_ASSIGNMENT_ERROR] = sizeof(njs_vmcode_variable_t),
+    [NJS_VMCODE_ERROR] = sizeof(njs_vmcode_error_t),
+    [NJS_VMCODE_MOVE] = sizeof(njs_vmcode_move_t),
+    [NJS_VMCODE_PROPERTY_GET] = sizeof(njs_vmcode_prop_get_t),
+    [NJS_VMCODE_INCREMENT] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_POST_INCREMENT] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_DECREMENT] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_POST_DECREMENT] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_TRY_RETURN] = sizeof(njs_vmcode_try_return_t),
+    [NJS_VMCODE_GLOBAL_GET] = sizeof(njs_vmcode_prop_get_t),
+    [NJS_VMCODE_LESS] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_GREATER] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_LESS_OR_EQUAL] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_GREATER_OR_EQUAL] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_ADDITION] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_EQUAL] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_NOT_EQUAL] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_SUBTRACTION] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_MULTIPLICATION] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_EXPONENTIATION] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_DIVISION] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_REMAINDER] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_BITWISE_AND] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_BITWISE_OR] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_BITWISE_XOR] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_LEFT_SHIFT] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_RIGHT_SHIFT] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_UNSIGNED_RIGHT_SHIFT] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_TEMPLATE_LITERAL] = sizeof(njs_vmcode_template_literal_t),
+    [NJS_VMCODE_PROPERTY_IN] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_PROPERTY_DELETE] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_PROPERTY_FOREACH] = sizeof(njs_vmcode_prop_foreach_t),
+    [NJS_VMCODE_STRICT_EQUAL] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_STRICT_NOT_EQUAL] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_TEST_IF_TRUE] = sizeof(njs_vmcode_test_jump_t),
+    [NJS_VMCODE_TEST_IF_FALSE] = sizeof(njs_vmcode_test_jump_t),
+    [NJS_VMCODE_COALESCE] = sizeof(njs_vmcode_test_jump_t),
+    [NJS_VMCODE_UNARY_PLUS] = sizeof(njs_vmcode_2addr_t),
+    [NJS_VMCODE_UNARY_NEGATION] = sizeof(njs_vmcode_2addr_t),
+    [NJS_VMCODE_BITWISE_NOT] = sizeof(njs_vmcode_2addr_t),
+    [NJS_VMCODE_LOGICAL_NOT] = sizeof(njs_vmcode_2addr_t),
+    [NJS_VMCODE_OBJECT] = sizeof(njs_vmcode_object_t),
+    [NJS_VMCODE_ARRAY] = sizeof(njs_vmcode_array_t),
+    [NJS_VMCODE_FUNCTION] = sizeof(njs_vmcode_function_t),
+    [NJS_VMCODE_REGEXP] = sizeof(njs_vmcode_regexp_t),
+    [NJS_VMCODE_INSTANCE_OF] = sizeof(njs_vmcode_instance_of_t),
+    [NJS_VMCODE_TYPEOF] = sizeof(njs_vmcode_2addr_t),
+    [NJS_VMCODE_VOID] = sizeof(njs_vmcode_2addr_t),
+    [NJS_VMCODE_DELETE] = sizeof(njs_vmcode_2addr_t),
+    [NJS_VMCODE_DEBUGGER] = sizeof(njs_vmcode_debugger_t),
+    [NJS_VMCODE_ADDITION_NUMBER] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_LESS_NUMBER] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_GREATER_NUMBER] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_LESS_OR_EQUAL_NUMBER] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_GREATER_OR_EQUAL_NUMBER] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_LESS_JUMP] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_GREATER_JUMP] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_LESS_OR_EQUAL_JUMP] = sizeof(njs_vmcode_3addr_t),
+    [NJS_VMCODE_GREATER_OR_EQUAL_JUMP] = sizeof(njs_vmcode_3addr_t),
+};
+
+
 #define njs_vmcode_operand(vm, index, _retval)                                \
     do {                                                                      \
         _retval = njs_scope_valid_value(vm, index);                           \
@@ -82,6 +181,41 @@ static njs_jump_off_t njs_function_frame_create(njs_vm_t *vm,
     } while (0)
 
 
+#define NJS_COND_JUMP_NEXT                                                    \
+                                                                              \
+        pc += sizeof(njs_vmcode_3addr_t);                                     \
+        cond_jump = (njs_vmcode_cond_jump_t *) pc;                            \
+                                                                              \
+        if (valid == (cond_jump->code == NJS_VMCODE_IF_TRUE_JUMP)) {          \
+            pc += cond_jump->offset;                                          \
+                                                                              \
+        } else {                                                              \
+            pc += sizeof(njs_vmcode_cond_jump_t);                             \
+        }                                                                     \
+                                                                              \
+        NEXT
+
+
+/*
+ * Tests whether a comparison is followed by a conditional jump
+ * on its result.
+ */
+
+njs_inline njs_bool_t
+njs_vmcode_cond_jump_follows(u_char *pc)
+{
+    njs_vmcode_3addr_t      *code;
+    njs_vmcode_cond_jump_t  *cond_jump;
+
+    code = (njs_vmcode_3addr_t *) pc;
+    cond_jump = (njs_vmcode_cond_jump_t *) (pc + sizeof(njs_vmcode_3addr_t));
+
+    return (cond_jump->code == NJS_VMCODE_IF_TRUE_JUMP
+            || cond_jump->code == NJS_VMCODE_IF_FALSE_JUMP)
+           && cond_jump->cond == code->dst;
+}
+
+
 njs_int_t
 njs_vmcode_interpreter(njs_vm_t *vm, u_char *pc, njs_value_t *rval,
     void *promise_cap, void *async_ctx)
@@ -101,6 +235,7 @@ njs_vmcode_interpreter(njs_vm_t *vm, u_char *pc, njs_value_t *rval,
     njs_jump_off_t               ret;
     njs_vmcode_1addr_t           *put_arg;
     njs_vmcode_await_t           *await;
+    njs_object_prop_t            *prop;
     njs_native_frame_t           *previous, *native;
     njs_property_next_t          *next;
     njs_vmcode_import_t          *import;
@@ -111,6 +246,7 @@ njs_vmcode_interpreter(njs_vm_t *vm, u_char *pc, njs_value_t *rval,
     njs_vmcode_prop_next_t       *pnext;
     njs_vmcode_test_jump_t       *test_jump;
     njs_vmcode_equal_jump_t      *equal;
+    njs_vmcode_cond_jump_t       *cond_jump;
     njs_vmcode_try_return_t      *try_return;
     njs_vmcode_method_frame_t    *method_frame;
     njs_vmcode_function_copy_t   *fcopy;
@@ -229,6 +365,15 @@ njs_vmcode_interpreter(njs_vm_t *vm, u_char *pc, njs_value_t *rval,
         NJS_GOTO_ROW(NJS_VMCODE_VOID),
         NJS_GOTO_ROW(NJS_VMCODE_DELETE),
         NJS_GOTO_ROW(NJS_VMCODE_DEBUGGER),
+        NJS_GOTO_ROW(NJS_VMCODE_ADDITION_NUMBER),
+        NJS_GOTO_ROW(NJS_VMCODE_LESS_NUMBER),
+        NJS_GOTO_ROW(NJS_VMCODE_GREATER_NUMBER),
+        NJS_GOTO_ROW(NJS_VMCODE_LESS_OR_EQUAL_NUMBER),
+        NJS_GOTO_ROW(NJS_VMCODE_GREATER_OR_EQUAL_NUMBER),
+        NJS_GOTO_ROW(NJS_VMCODE_LESS_JUMP),
+        NJS_GOTO_ROW(NJS_VMCODE_GREATER_JUMP),
+        NJS_GOTO_ROW(NJS_VMCODE_LESS_OR_EQUAL_JUMP),
+        NJS_GOTO_ROW(NJS_VMCODE_GREATER_OR_EQUAL_JUMP),
     };
 
 #endif
@@ -258,6 +403,23 @@ NEXT_LBL;
         get = (njs_vmcode_prop_get_t *) pc;
         njs_vmcode_operand(vm, get->value, retval);
 
+        if (njs_is_string(value2) && njs_object_prop_cacheable(value1)) {
+            prop = njs_object_prop_cache_find(&get->cache, njs_object(value1),
+                                              value2);
+            if (prop == NULL) {
+                prop = njs_object_prop_cache_fill(vm, &get->cache,
+                                                  njs_object(value1), value2,
+                                                  get->hash);
+            }
+
+            if (prop != NULL) {
+                njs_value_assign(retval, njs_prop_value(prop));
+
+                pc += sizeof(njs_vmcode_prop_get_t);
+                NEXT;
+            }
+        }
+
         if (njs_slow_path(!njs_is_index_or_key(value2))) {
             if (njs_slow_path(njs_is_null_or_undefined(value1))) {
                 (void) njs_throw_cannot_property(vm, value1, value2, "get");
@@ -272,7 +434,7 @@ NEXT_LBL;
             value2 = &primitive1;
         }
 
-        ret = njs_value_property(vm, value1, value2, retval);
+        ret = njs_value_property_hash(vm, value1, value2, get->hash, retval);
         if (njs_slow_path(ret == NJS_ERROR)) {
             goto error;
         }
@@ -397,7 +559,7 @@ NEXT_LBL;
         get = (njs_vmcode_prop_get_t *) pc;
         njs_vmcode_operand(vm, get->value, retval);
 
-        ret = njs_value_property(vm, value1, value2, retval);
+        ret = njs_value_property_hash(vm, value1, value2, get->hash, retval);
         if (njs_slow_path(ret == NJS_ERROR)) {
             goto error;
         }
@@ -432,6 +594,13 @@ NEXT_LBL;
         njs_vmcode_operand(vm, vmcode->operand3, value2);
         njs_vmcode_operand(vm, vmcode->operand2, value1);
 
+        if (njs_is_numeric(value1) && njs_is_numeric(value2)) {
+            vmcode->code = njs_vmcode_cond_jump_follows(pc)
+                           ? NJS_VMCODE_LESS_JUMP
+                           : NJS_VMCODE_LESS_NUMBER;
+            NEXT;
+        }
+
         if (njs_slow_path(!njs_is_primitive(value1))) {
             ret = njs_value_to_primitive(vm, &primitive1, value1, 0);
             if (ret != NJS_OK) {
@@ -465,12 +634,59 @@ NEXT_LBL;
         pc += sizeof(njs_vmcode_3addr_t);
         NEXT;
 
+    CASE (NJS_VMCODE_LESS_NUMBER):
+        njs_vmcode_debug_opcode();
+
+        njs_vmcode_operand(vm, vmcode->operand3, value2);
+        njs_vmcode_operand(vm, vmcode->operand2, value1);
+
+        if (njs_slow_path(!njs_is_numeric(value1)
+                          || !njs_is_numeric(value2)))
+        {
+            vmcode->code = NJS_VMCODE_LESS;
+            NEXT;
+        }
+
+        njs_vmcode_operand(vm, vmcode->operand1, retval);
+
+        njs_set_boolean(retval, njs_number(value1) < njs_number(value2));
+
+        pc += sizeof(njs_vmcode_3addr_t);
+        NEXT;
+
+    CASE (NJS_VMCODE_LESS_JUMP):
+        njs_vmcode_debug_opcode();
+
+        njs_vmcode_operand(vm, vmcode->operand3, value2);
+        njs_vmcode_operand(vm, vmcode->operand2, value1);
+
+        if (njs_slow_path(!njs_is_numeric(value1)
+                          || !njs_is_numeric(value2)))
+        {
+            vmcode->code = NJS_VMCODE_LESS;
+            NEXT;
+        }
+
+        njs_vmcode_operand(vm, vmcode->operand1, retval);
+
+        valid = (njs_number(value1) < njs_number(value2));
+        njs_set_boolean(retval, valid);
+
+        NJS_COND_JUMP_NEXT;
+
     CASE (NJS_VMCODE_GREATER):
         njs_vmcode_debug_opcode();
 
         njs_vmcode_operand(vm, vmcode->operand3, value2);
         njs_vmcode_operand(vm, vmcode->operand2, value1);
 
+        if (njs_is_numeric(value1) && njs_is_numeric(value2)) {
+            vmcode->code = njs_vmcode_cond_jump_follows(pc)
+                           ? NJS_VMCODE_GREATER_JUMP
+                           : NJS_VMCODE_GREATER_NUMBER;
+            NEXT;
+        }
+
         if (njs_slow_path(!njs_is_primitive(value1))) {
             ret = njs_value_to_primitive(vm, &primitive1, value1, 0);
             if (ret != NJS_OK) {
@@ -504,12 +720,59 @@ NEXT_LBL;
         pc += sizeof(njs_vmcode_3addr_t);
         NEXT;
 
+    CASE (NJS_VMCODE_GREATER_NUMBER):
+        njs_vmcode_debug_opcode();
+
+        njs_vmcode_operand(vm, vmcode->operand3, value2);
+        njs_vmcode_operand(vm, vmcode->operand2, value1);
+
+        if (njs_slow_path(!njs_is_numeric(value1)
+                          || !njs_is_numeric(value2)))
+        {
+            vmcode->code = NJS_VMCODE_GREATER;
+            NEXT;
+        }
+
+        njs_vmcode_operand(vm, vmcode->operand1, retval);
+
+        njs_set_boolean(retval, njs_number(value1) > njs_number(value2));
+
+        pc += sizeof(njs_vmcode_3addr_t);
+        NEXT;
+
+    CASE (NJS_VMCODE_GREATER_JUMP):
+        njs_vmcode_debug_opcode();
+
+        njs_vmcode_operand(vm, vmcode->operand3, value2);
+        njs_vmcode_operand(vm, vmcode->operand2, value1);
+
+        if (njs_slow_path(!njs_is_numeric(value1)
+                          || !njs_is_numeric(value2)))
+        {
+            vmcode->code = NJS_VMCODE_GREATER;
+            NEXT;
+        }
+
+        njs_vmcode_operand(vm, vmcode->operand1, retval);
+
+        valid = (njs_number(value1) > njs_number(value2));
+        njs_set_boolean(retval, valid);
+
+        NJS_COND_JUMP_NEXT;
+
     CASE (NJS_VMCODE_LESS_OR_EQUAL):
         njs_vmcode_debug_opcode();
 
         njs_vmcode_operand(vm, vmcode->operand3, value2);
         njs_vmcode_operand(vm, vmcode->operand2, value1);
 
+        if (njs_is_numeric(value1) && njs_is_numeric(value2)) {
+            vmcode->code = njs_vmcode_cond_jump_follows(pc)
+                           ? NJS_VMCODE_LESS_OR_EQUAL_JUMP
+                           : NJS_VMCODE_LESS_OR_EQUAL_NUMBER;
+            NEXT;
+        }
+
         if (njs_slow_path(!njs_is_primitive(value1))) {
             ret = njs_value_to_primitive(vm, &primitive1, value1, 0);
             if (ret != NJS_OK) {
@@ -543,12 +806,59 @@ NEXT_LBL;
         pc += sizeof(njs_vmcode_3addr_t);
         NEXT;
 
+    CASE (NJS_VMCODE_LESS_OR_EQUAL_NUMBER):
+        njs_vmcode_debug_opcode();
+
+        njs_vmcode_operand(vm, vmcode->operand3, value2);
+        njs_vmcode_operand(vm, vmcode->operand2, value1);
+
+        if (njs_slow_path(!njs_is_numeric(value1)
+                          || !njs_is_numeric(value2)))
+        {
+            vmcode->code = NJS_VMCODE_LESS_OR_EQUAL;
+            NEXT;
+        }
+
+        njs_vmcode_operand(vm, vmcode->operand1, retval);
+
+        njs_set_boolean(retval, njs_number(value1) <= njs_number(value2));
+
+        pc += sizeof(njs_vmcode_3addr_t);
+        NEXT;
+
+    CASE (NJS_VMCODE_LESS_OR_EQUAL_JUMP):
+        njs_vmcode_debug_opcode();
+
+        njs_vmcode_operand(vm, vmcode->operand3, value2);
+        njs_vmcode_operand(vm, vmcode->operand2, value1);
+
+        if (njs_slow_path(!njs_is_numeric(value1)
+                          || !njs_is_numeric(value2)))
+        {
+            vmcode->code = NJS_VMCODE_LESS_OR_EQUAL;
+            NEXT;
+        }
+
+        njs_vmcode_operand(vm, vmcode->operand1, retval);
+
+        valid = (njs_number(value1) <= njs_number(value2));
+        njs_set_boolean(retval, valid);
+
+        NJS_COND_JUMP_NEXT;
+
     CASE (NJS_VMCODE_GREATER_OR_EQUAL):
         njs_vmcode_debug_opcode();
 
         njs_vmcode_operand(vm, vmcode->operand3, value2);
         njs_vmcode_operand(vm, vmcode->operand2, value1);
 
+        if (njs_is_numeric(value1) && njs_is_numeric(value2)) {
+            vmcode->code = njs_vmcode_cond_jump_follows(pc)
+                           ? NJS_VMCODE_GREATER_OR_EQUAL_JUMP
+                           : NJS_VMCODE_GREATER_OR_EQUAL_NUMBER;
+            NEXT;
+        }
+
         if (njs_slow_path(!njs_is_primitive(value1))) {
             ret = njs_value_to_primitive(vm, &primitive1, value1, 0);
             if (ret != NJS_OK) {
@@ -582,12 +892,57 @@ NEXT_LBL;
         pc += sizeof(njs_vmcode_3addr_t);
         NEXT;
 
+    CASE (NJS_VMCODE_GREATER_OR_EQUAL_NUMBER):
+        njs_vmcode_debug_opcode();
+
+        njs_vmcode_operand(vm, vmcode->operand3, value2);
+        njs_vmcode_operand(vm, vmcode->operand2, value1);
+
+        if (njs_slow_path(!njs_is_numeric(value1)
+                          || !njs_is_numeric(value2)))
+        {
+            vmcode->code = NJS_VMCODE_GREATER_OR_EQUAL;
+            NEXT;
+        }
+
+        njs_vmcode_operand(vm, vmcode->operand1, retval);
+
+        njs_set_boolean(retval, njs_number(value1) >= njs_number(value2));
+
+        pc += sizeof(njs_vmcode_3addr_t);
+        NEXT;
+
+    CASE (NJS_VMCODE_GREATER_OR_EQUAL_JUMP):
+        njs_vmcode_debug_opcode();
+
+        njs_vmcode_operand(vm, vmcode->operand3, value2);
+        njs_vmcode_operand(vm, vmcode->operand2, value1);
+
+        if (njs_slow_path(!njs_is_numeric(value1)
+                          || !njs_is_numeric(value2)))
+        {
+            vmcode->code = NJS_VMCODE_GREATER_OR_EQUAL;
+            NEXT;
+        }
+
+        njs_vmcode_operand(vm, vmcode->operand1, retval);
+
+        valid = (njs_number(value1) >= njs_number(value2));
+        njs_set_boolean(retval, valid);
+
+        NJS_COND_JUMP_NEXT;
+
     CASE (NJS_VMCODE_ADDITION):
         njs_vmcode_debug_opcode();
 
         njs_vmcode_operand(vm, vmcode->operand3, value2);
         njs_vmcode_operand(vm, vmcode->operand2, value1);
 
+        if (njs_is_numeric(value1) && njs_is_numeric(value2)) {
+            vmcode->code = NJS_VMCODE_ADDITION_NUMBER;
+            NEXT;
+        }
+
         if (njs_slow_path(!njs_is_primitive(value1))) {
             hint = njs_is_date(value1);
             ret = njs_value_to_primitive(vm, &primitive1, value1, hint);
@@ -653,6 +1008,26 @@ NEXT_LBL;
 
         BREAK;
 
+    CASE (NJS_VMCODE_ADDITION_NUMBER):
+        njs_vmcode_debug_opcode();
+
+        njs_vmcode_operand(vm, vmcode->operand3, value2);
+        njs_vmcode_operand(vm, vmcode->operand2, value1);
+
+        if (njs_slow_path(!njs_is_numeric(value1)
+                          || !njs_is_numeric(value2)))
+        {
+            vmcode->code = NJS_VMCODE_ADDITION;
+            NEXT;
+        }
+
+        njs_vmcode_operand(vm, vmcode->operand1, retval);
+
+        njs_set_number(retval, njs_number(value1) + njs_number(value2));
+
+        pc += sizeof(njs_vmcode_3addr_t);
+        NEXT;
+
     CASE (NJS_VMCODE_EQUAL):
         njs_vmcode_debug_opcode();
 
@@ -1100,7 +1475,7 @@ NEXT_LBL;
 
         njs_vmcode_operand(vm, vmcode->operand1, retval);
 
-        ret = njs_vmcode_object(vm, retval);
+        ret = njs_vmcode_object(vm, pc, retval);
         if (njs_slow_path(ret < 0 && ret >= NJS_PREEMPT)) {
             goto error;
         }
@@ -1239,6 +1614,28 @@ NEXT_LBL;
         njs_vmcode_operand(vm, vmcode->operand2, value1);
         njs_vmcode_operand(vm, vmcode->operand1, retval);
 
+        set = (njs_vmcode_prop_set_t *) pc;
+
+        if (njs_is_string(value2)
+            && njs_object_prop_cacheable(value1)
+            && !njs_is_array(value1))
+        {
+            prop = njs_object_prop_cache_find(&set->cache, njs_object(value1),
+                                              value2);
+            if (prop == NULL) {
+                prop = njs_object_prop_cache_fill(vm, &set->cache,
+                                                  njs_object(value1), value2,
+                                                  set->hash);
+            }
+
+            if (prop != NULL && prop->writable) {
+                njs_value_assign(njs_prop_value(prop), retval);
+
+                ret = sizeof(njs_vmcode_prop_set_t);
+                BREAK;
+            }
+        }
+
         if (njs_slow_path(!njs_is_index_or_key(value2))) {
             if (njs_slow_path(njs_is_null_or_undefined(value1))) {
                 (void) njs_throw_cannot_property(vm, value1, value2, "set");
@@ -1255,7 +1652,8 @@ NEXT_LBL;
             value2 = &primitive2;
         }
 
-        ret = njs_value_property_set(vm, value1, value2, retval);
+        ret = njs_value_property_set_hash(vm, value1, value2, set->hash,
+                                          retval);
         if (njs_slow_path(ret == NJS_ERROR)) {
             goto error;
         }
@@ -1339,7 +1737,25 @@ NEXT_LBL;
 
         set = (njs_vmcode_prop_set_t *) pc;
         njs_vmcode_operand(vm, set->value, retval);
-        ret = njs_vmcode_property_init(vm, value1, value2, retval);
+
+        if (njs_is_string(value2) && value1->type == NJS_OBJECT) {
+            prop = njs_object_prop_cache_find(&set->cache, njs_object(value1),
+                                              value2);
+            if (prop == NULL) {
+                prop = njs_object_prop_cache_fill(vm, &set->cache,
+                                                  njs_object(value1), value2,
+                                                  set->hash);
+            }
+
+            if (prop != NULL && prop->writable) {
+                njs_value_assign(njs_prop_value(prop), retval);
+
+                ret = sizeof(njs_vmcode_prop_set_t);
+                BREAK;
+            }
+        }
+
+        ret = njs_vmcode_property_init(vm, value1, value2, set->hash, retval);
         if (njs_slow_path(ret == NJS_ERROR)) {
             goto error;
         }
@@ -1411,7 +1827,8 @@ NEXT_LBL;
             value2 = &primitive1;
         }
 
-        ret = njs_value_property(vm, value1, value2, &dst);
+        ret = njs_value_property_hash(vm, value1, value2, method_frame->hash,
+                                      &dst);
         if (njs_slow_path(ret == NJS_ERROR)) {
             goto error;
         }
@@ -1807,11 +2224,19 @@ error:
 
 
 static njs_jump_off_t
-njs_vmcode_object(njs_vm_t *vm, njs_value_t *retval)
+njs_vmcode_object(njs_vm_t *vm, u_char *pc, njs_value_t *retval)
 {
-    njs_object_t  *object;
+    njs_object_t         *object;
+    njs_vmcode_object_t  *code;
 
-    object = njs_object_alloc(vm);
+    code = (njs_vmcode_object_t *) pc;
+
+    if (code->shape != NULL) {
+        object = njs_object_shape_alloc(vm, code->shape);
+
+    } else {
+        object = njs_object_alloc(vm);
+    }
 
     if (njs_fast_path(object != NULL)) {
         njs_set_object(retval, object);
@@ -1989,7 +2414,7 @@ njs_vmcode_function_copy(njs_vm_t *vm, njs_value_t *value, njs_index_t retidx)
 
 static njs_jump_off_t
 njs_vmcode_property_init(njs_vm_t *vm, njs_value_t *value, njs_value_t *key,
-    njs_value_t *init)
+    uint32_t hash, njs_value_t *init)
 {
     double              num;
     uint32_t            index, size;
@@ -2040,7 +2465,7 @@ njs_vmcode_property_init(njs_vm_t *vm, njs_value_t *value, njs_value_t *key,
             return NJS_ERROR;
         }
 
-        njs_object_property_key_set(&lhq, &name, 0);
+        njs_object_property_key_set(&lhq, &name, hash);
         lhq.proto = &njs_object_hash_proto;
         lhq.pool = vm->mem_pool;
 
@@ -2054,7 +2479,7 @@ njs_vmcode_property_init(njs_vm_t *vm, njs_value_t *value, njs_value_t *key,
 
         ret = njs_lvlhsh_insert(njs_object_hash(value), &lhq);
         if (njs_slow_path(ret != NJS_OK)) {
-            njs_internal_error(vm, "lvlhsh insert/replace failed");
+            njs_memory_error(vm);
             return NJS_ERROR;
         }
 
@@ -2320,6 +2745,20 @@ njs_string_concat(njs_vm_t *vm, njs_value_t *val1, njs_value_t *val2,
     length = string1.length + string2.length;
     size = string1.size + string2.size;
 
+    if (size == length && size > NJS_STRING_SHORT) {
+        start = njs_string_extend(vm, retval, &string1,
+                                  val1->short_string.size == NJS_STRING_LONG
+                                  && val1->long_string.data->buffer,
+                                  size);
+        if (njs_slow_path(start == NULL)) {
+            return NJS_ERROR;
+        }
+
+        (void) memcpy(start, string2.start, string2.size);
+
+        return sizeof(njs_vmcode_3addr_t);
+    }
+
     start = njs_string_alloc(vm, retval, size, length);
     if (njs_slow_path(start == NULL)) {
         return NJS_ERROR;
@@ -110,6 +110,26 @@ enum {
     NJS_VMCODE_VOID,
     NJS_VMCODE_DELETE,
     NJS_VMCODE_DEBUGGER,
+
+    /*
+     * Specialized variants of generic operations, a generic operation
+     * is rewritten in place into its variant when all its operands
+     * are numeric, and back otherwise.
+     */
+    NJS_VMCODE_ADDITION_NUMBER,
+    NJS_VMCODE_LESS_NUMBER,
+    NJS_VMCODE_GREATER_NUMBER,
+    NJS_VMCODE_LESS_OR_EQUAL_NUMBER,
+    NJS_VMCODE_GREATER_OR_EQUAL_NUMBER,
+
+    /*
+     * Numeric comparisons which also perform the conditional jump
+     * on their result that immediately follows them.
+     */
+    NJS_VMCODE_LESS_JUMP,
+    NJS_VMCODE_GREATER_JUMP,
+    NJS_VMCODE_LESS_OR_EQUAL_JUMP,
+    NJS_VMCODE_GREATER_OR_EQUAL_JUMP,
     NJS_VMCODES
 };
 
@@ -153,6 +173,7 @@ typedef struct {
 typedef struct {
     njs_vmcode_t               code;
     njs_index_t                retval;
+    njs_object_shape_t         *shape;
 } njs_vmcode_object_t;
 
 
@@ -238,6 +259,8 @@ typedef struct {
     njs_index_t                value;
     njs_index_t                object;
     njs_index_t                property;
+    uint32_t                   hash;
+    njs_prop_cache_t           cache;
 } njs_vmcode_prop_get_t;
 
 
@@ -246,6 +269,8 @@ typedef struct {
     njs_index_t                value;
     njs_index_t                object;
     njs_index_t                property;
+    uint32_t                   hash;
+    njs_prop_cache_t           cache;
 } njs_vmcode_prop_set_t;
 
 
@@ -296,6 +321,7 @@ typedef struct {
     njs_index_t                nargs;
     njs_index_t                object;
     njs_index_t                method;
+    uint32_t                   hash;
     uint8_t                    ctor;       /* 1 bit  */
 } njs_vmcode_method_frame_t;
 
@@ -411,6 +437,8 @@ typedef struct {
 } njs_vmcode_await_t;
 
 
+extern const uint8_t  njs_vmcode_size[NJS_VMCODES];
+
 njs_int_t njs_vmcode_interpreter(njs_vm_t *vm, u_char *pc, njs_value_t *retval,
     void *promise_cap, void *async_ctx);
 
@@ -0,0 +1,716 @@
+/*
+ * Copyright (C) NGINX, Inc.
+ */
+
+
+#include <njs_main.h>
+
+#include <signal.h>
+#include <sys/wait.h>
+
+
+typedef struct {
+    u_char      *p;
+    size_t      size;
+    u_char      fill;
+} mp_unit_test_item_t;
+
+
+static njs_mp_t *mp_unit_test_create(size_t cluster_size);
+static njs_int_t mp_unit_test_alloc(njs_mp_t *mp, mp_unit_test_item_t *item,
+    size_t alignment, size_t size, njs_uint_t n);
+static njs_int_t mp_unit_test_free(njs_mp_t *mp, mp_unit_test_item_t *item);
+static njs_int_t mp_unit_test_empty(njs_mp_t *mp);
+static int njs_cdecl mp_unit_test_sort_cmp(const void *one, const void *two,
+    void *ctx);
+
+
+static njs_mp_t *
+mp_unit_test_create(size_t cluster_size)
+{
+    njs_mp_t  *mp;
+
+    const size_t  min_chunk_size = 32;
+    const size_t  page_size = 1024;
+    const size_t  page_alignment = 128;
+
+    mp = njs_mp_create(cluster_size, page_alignment, page_size, min_chunk_size);
+    if (mp == NULL) {
+        njs_printf("mp unit test failed: njs_mp_create(%uz)\n", cluster_size);
+    }
+
+    return mp;
+}
+
+
+static njs_int_t
+mp_unit_test_alloc(njs_mp_t *mp, mp_unit_test_item_t *item, size_t alignment,
+    size_t size, njs_uint_t n)
+{
+    item->p = njs_mp_align(mp, alignment, size);
+    item->size = size;
+
+    if (item->p == NULL) {
+        njs_printf("mp unit test failed: allocation %l of %uz bytes\n",
+                   (long) n, size);
+        return NJS_ERROR;
+    }
+
+    if (((uintptr_t) item->p & (alignment - 1)) != 0) {
+        njs_printf("mp unit test failed: allocation %l is not aligned "
+                   "to %uz: %p\n", (long) n, alignment, item->p);
+        return NJS_ERROR;
+    }
+
+    item->fill = (u_char) n;
+    njs_memset(item->p, item->fill, size);
+
+    return NJS_OK;
+}
+
+
+/*
+ * Freed chunks are filled with junk, so a free of a wrong chunk
+ * is detected by the contents of the allocations which are still used.
+ */
+
+static njs_int_t
+mp_unit_test_free(njs_mp_t *mp, mp_unit_test_item_t *item)
+{
+    size_t  i;
+
+    for (i = 0; i < item->size; i++) {
+        if (item->p[i] != item->fill) {
+            njs_printf("mp unit test failed: allocation %p of %uz bytes "
+                       "is corrupted at %uz\n", item->p, item->size, i);
+            return NJS_ERROR;
+        }
+    }
+
+    njs_mp_free(mp, item->p);
+
+    item->p = NULL;
+
+    return NJS_OK;
+}
+
+
+static njs_int_t
+mp_unit_test_empty(njs_mp_t *mp)
+{
+    njs_mp_stat_t  stat;
+
+    njs_mp_stat(mp, &stat);
+
+    if (!njs_mp_is_empty(mp) || stat.size != 0 || stat.nblocks != 0) {
+        njs_printf("mp unit test failed: pool is not empty: "
+                   "%uz bytes in %uz blocks\n", stat.size, stat.nblocks);
+        return NJS_ERROR;
+    }
+
+    return NJS_OK;
+}
+
+
+/*
+ * Chunks of various sizes spread over many clusters are freed
+ * in different orders, so clusters are looked up by arbitrary pointers
+ * and released while other clusters are still used.
+ */
+
+static njs_int_t
+mp_unit_test_interleaved(njs_uint_t n)
+{
+    uint32_t             key;
+    njs_mp_t             *mp;
+    njs_int_t            ret;
+    njs_uint_t           i, j;
+    njs_mp_stat_t        stat;
+    mp_unit_test_item_t  *items;
+
+    njs_printf("mp interleaved free unit test started: %l items\n", (long) n);
+
+    ret = NJS_ERROR;
+
+    items = malloc(n * sizeof(mp_unit_test_item_t));
+    if (items == NULL) {
+        return NJS_ERROR;
+    }
+
+    mp = mp_unit_test_create(4096);
+    if (mp == NULL) {
+        goto done;
+    }
+
+    key = 0;
+
+    for (i = 0; i < n; i++) {
+        key = njs_murmur_hash2(&key, sizeof(uint32_t));
+
+        if (mp_unit_test_alloc(mp, &items[i], NJS_MAX_ALIGNMENT,
+                               key % 1024 + 1, i) != NJS_OK)
+        {
+            goto done;
+        }
+    }
+
+    njs_mp_stat(mp, &stat);
+
+    if (stat.nblocks < 8) {
+        njs_printf("mp interleaved free unit test failed: "
+                   "%uz clusters\n", stat.nblocks);
+        goto done;
+    }
+
+    /* Every third allocation starting from the end. */
+
+    for (i = n; i-- != 0; /* void */) {
+        if (i % 3 == 0 && mp_unit_test_free(mp, &items[i]) != NJS_OK) {
+            goto done;
+        }
+    }
+
+    /* The next third in an order unrelated to addresses. */
+
+    for (i = 0; i < n; i++) {
+        j = (i * 7919) % n;
+
+        if (j % 3 == 1 && mp_unit_test_free(mp, &items[j]) != NJS_OK) {
+            goto done;
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        if (items[i].p != NULL && mp_unit_test_free(mp, &items[i]) != NJS_OK) {
+            goto done;
+        }
+    }
+
+    ret = mp_unit_test_empty(mp);
+
+    if (ret == NJS_OK) {
+        njs_printf("mp interleaved free unit test passed\n");
+    }
+
+done:
+
+    if (mp != NULL) {
+        njs_mp_destroy(mp);
+    }
+
+    free(items);
+
+    return ret;
+}
+
+
+/*
+ * The first and the last chunks of clusters are freed first.  Clusters
+ * are found by the address of the chunk in the same or in the previous
+ * hash bucket, the size of clusters which are not a power of 2 is rounded
+ * up to compute the bucket.
+ */
+
+static njs_int_t
+mp_unit_test_boundaries(size_t cluster_size, size_t size)
+{
+    u_char               *edges;
+    njs_mp_t             *mp;
+    njs_int_t            ret;
+    njs_uint_t           i, n, nedges;
+    mp_unit_test_item_t  *items;
+
+    njs_printf("mp cluster boundaries unit test started: "
+               "cluster:%uz chunk:%uz\n", cluster_size, size);
+
+    ret = NJS_ERROR;
+    mp = NULL;
+    n = 16 * (cluster_size / size);
+
+    items = malloc(n * (sizeof(mp_unit_test_item_t) + 1));
+    if (items == NULL) {
+        return NJS_ERROR;
+    }
+
+    edges = (u_char *) &items[n];
+
+    mp = mp_unit_test_create(cluster_size);
+    if (mp == NULL) {
+        goto done;
+    }
+
+    for (i = 0; i < n; i++) {
+        if (mp_unit_test_alloc(mp, &items[i], NJS_MAX_ALIGNMENT, size, i)
+            != NJS_OK)
+        {
+            goto done;
+        }
+    }
+
+    njs_qsort(items, n, sizeof(mp_unit_test_item_t), mp_unit_test_sort_cmp,
+              NULL);
+
+    /* A chunk is at a boundary if the adjacent one is not contiguous. */
+
+    nedges = 0;
+
+    for (i = 0; i < n; i++) {
+        edges[i] = (i == 0 || items[i - 1].p + size != items[i].p
+                    || i == n - 1 || items[i].p + size != items[i + 1].p);
+
+        nedges += edges[i];
+    }
+
+    if (nedges < 2) {
+        njs_printf("mp cluster boundaries unit test failed: "
+                   "%l boundary chunks\n", (long) nedges);
+        goto done;
+    }
+
+    for (i = 0; i < n; i++) {
+        if (edges[i] && mp_unit_test_free(mp, &items[i]) != NJS_OK) {
+            goto done;
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        if (items[i].p != NULL && mp_unit_test_free(mp, &items[i]) != NJS_OK) {
+            goto done;
+        }
+    }
+
+    ret = mp_unit_test_empty(mp);
+
+    if (ret == NJS_OK) {
+        njs_printf("mp cluster boundaries unit test passed\n");
+    }
+
+done:
+
+    if (mp != NULL) {
+        njs_mp_destroy(mp);
+    }
+
+    free(items);
+
+    return ret;
+}
+
+
+/*
+ * Chunks, pages and large blocks of both types are allocated and freed
+ * in turn, so clusters and large blocks are interleaved in memory.
+ */
+
+static njs_int_t
+mp_unit_test_mixed(njs_uint_t n)
+{
+    size_t               size, alignment;
+    uint32_t             key;
+    njs_mp_t             *mp;
+    njs_int_t            ret;
+    njs_uint_t           i, j;
+    mp_unit_test_item_t  items[64];
+
+    njs_printf("mp mixed allocations unit test started: %l items\n", (long) n);
+
+    ret = NJS_ERROR;
+
+    mp = mp_unit_test_create(4096);
+    if (mp == NULL) {
+        return NJS_ERROR;
+    }
+
+    njs_memzero(items, sizeof(items));
+
+    key = 0;
+
+    for (i = 0; i < n; i++) {
+        key = njs_murmur_hash2(&key, sizeof(uint32_t));
+        j = key % njs_nitems(items);
+
+        if (items[j].p != NULL && mp_unit_test_free(mp, &items[j]) != NJS_OK) {
+            goto done;
+        }
+
+        switch ((key >> 8) % 4) {
+        case 0:
+            size = (key >> 12) % 512 + 1;
+            break;
+
+        case 1:
+            size = 1024;
+            break;
+
+        case 2:
+            /* A power of 2, the block is allocated apart. */
+            size = 2048 << ((key >> 12) % 3);
+            break;
+
+        default:
+            /* The block is allocated just after the allocation. */
+            size = 1025 + (key >> 12) % 8192;
+            break;
+        }
+
+        alignment = ((key >> 24) % 2) ? 64 : NJS_MAX_ALIGNMENT;
+
+        if (mp_unit_test_alloc(mp, &items[j], alignment, size, i) != NJS_OK) {
+            goto done;
+        }
+    }
+
+    for (j = 0; j < njs_nitems(items); j++) {
+        if (items[j].p != NULL && mp_unit_test_free(mp, &items[j]) != NJS_OK) {
+            goto done;
+        }
+    }
+
+    ret = mp_unit_test_empty(mp);
+
+    if (ret == NJS_OK) {
+        njs_printf("mp mixed allocations unit test passed\n");
+    }
+
+done:
+
+    njs_mp_destroy(mp);
+
+    return ret;
+}
+
+
+#if !(NJS_DEBUG_MEMORY)
+
+/*
+ * An invalid free is reported and aborts the process in debug builds,
+ * otherwise it is ignored and the pool remains consistent.
+ */
+
+static njs_int_t
+mp_unit_test_invalid_free(void)
+{
+    u_char      *p, *q;
+    njs_mp_t    *mp;
+    njs_int_t   ret;
+    njs_uint_t  i;
+#if (NJS_DEBUG)
+    int         fd[2], status;
+    char        buf[256];
+    pid_t       pid;
+    ssize_t     n;
+#else
+    u_char      *r1, *r2;
+#endif
+
+    static const struct {
+        size_t      size;
+        size_t      offset;
+        njs_bool_t  twice;
+        const char  *error;
+    } tests[] = {
+        { 64, 0, 1, "freed pointer points to already free chunk" },
+        { 64, 8, 0, "freed pointer points to wrong chunk" },
+        { 1024, 0, 1, "freed pointer points to already free page" },
+        { 1024, 8, 0, "invalid pointer to chunk" },
+    };
+
+    njs_printf("mp invalid free unit test started\n");
+
+    for (i = 0; i < njs_nitems(tests); i++) {
+        mp = mp_unit_test_create(4096);
+        if (mp == NULL) {
+            return NJS_ERROR;
+        }
+
+        ret = NJS_ERROR;
+
+        /* The first allocation keeps the page or the cluster used. */
+
+        q = njs_mp_alloc(mp, tests[i].size);
+        p = njs_mp_alloc(mp, tests[i].size);
+
+        if (p == NULL || q == NULL) {
+            goto done;
+        }
+
+#if (NJS_DEBUG)
+
+        if (pipe(fd) != 0) {
+            goto done;
+        }
+
+        pid = fork();
+
+        if (pid == -1) {
+            close(fd[0]);
+            close(fd[1]);
+            goto done;
+        }
+
+        if (pid == 0) {
+            (void) dup2(fd[1], STDERR_FILENO);
+
+            if (tests[i].twice) {
+                njs_mp_free(mp, p);
+            }
+
+            njs_mp_free(mp, p + tests[i].offset);
+
+            _exit(0);
+        }
+
+        close(fd[1]);
+
+        n = read(fd[0], buf, sizeof(buf) - 1);
+        buf[njs_max(n, 0)] = '\0';
+
+        close(fd[0]);
+
+        if (waitpid(pid, &status, 0) != pid
+            || !WIFSIGNALED(status) || WTERMSIG(status) != SIGABRT
+            || strstr(buf, tests[i].error) == NULL)
+        {
+            njs_printf("mp invalid free unit test failed: \"%s\"\n"
+                       "expected: \"%s\"\n", buf, tests[i].error);
+            goto done;
+        }
+
+#else
+
+        if (tests[i].twice) {
+            njs_mp_free(mp, p);
+        }
+
+        njs_mp_free(mp, p + tests[i].offset);
+
+        /* The invalid free is ignored, a chunk is not returned twice. */
+
+        r1 = njs_mp_alloc(mp, tests[i].size);
+        r2 = njs_mp_alloc(mp, tests[i].size);
+
+        if (r1 == NULL || r2 == NULL || r1 == r2 || r1 == q || r2 == q
+            || (!tests[i].twice && (r1 == p || r2 == p)))
+        {
+            njs_printf("mp invalid free unit test failed: \"%s\"\n",
+                       tests[i].error);
+            goto done;
+        }
+
+#endif
+
+        ret = NJS_OK;
+
+    done:
+
+        njs_mp_destroy(mp);
+
+        if (ret != NJS_OK) {
+            return NJS_ERROR;
+        }
+    }
+
+    njs_printf("mp invalid free unit test passed\n");
+
+    return NJS_OK;
+}
+
+
+/*
+ * Small allocations are served from the nursery until it is exhausted,
+ * then from clusters.  Freeing of nursery chunks is a no-op, a reset
+ * rewinds the nursery and releases large blocks.
+ */
+
+static njs_int_t
+mp_unit_test_nursery(void)
+{
+    u_char         *first, *p, *large;
+    njs_mp_t       *mp;
+    njs_int_t      ret;
+    njs_uint_t     i, n;
+    njs_mp_stat_t  start, stat;
+
+    const size_t   size = 64;
+    const size_t   nursery_size = 4096;
+
+    njs_printf("mp nursery unit test started\n");
+
+    mp = mp_unit_test_create(4096);
+    if (mp == NULL) {
+        return NJS_ERROR;
+    }
+
+    ret = NJS_ERROR;
+
+    if (njs_mp_nursery(mp, nursery_size) != NJS_OK) {
+        goto done;
+    }
+
+    njs_mp_stat(mp, &start);
+
+    if (start.nblocks != 1 || start.size != nursery_size) {
+        njs_printf("mp nursery unit test failed: "
+                   "%uz bytes in %uz blocks\n", start.size, start.nblocks);
+        goto done;
+    }
+
+    /* The nursery is rewound by the reset in the second round. */
+
+    for (n = 0; n < 2; n++) {
+        first = njs_mp_alloc(mp, size);
+        if (first == NULL) {
+            goto done;
+        }
+
+        njs_memset(first, 0xA5, size);
+
+        for (i = 1; i < nursery_size / size; i++) {
+            p = njs_mp_alloc(mp, size);
+            if (p != first + i * size) {
+                njs_printf("mp nursery unit test failed: "
+                           "chunk %l at %p\n", (long) i, p);
+                goto done;
+            }
+        }
+
+        njs_mp_free(mp, first);
+
+        njs_mp_stat(mp, &stat);
+
+        if (first[0] != 0xA5 || stat.nblocks != start.nblocks
+            || stat.size != start.size)
+        {
+            njs_printf("mp nursery unit test failed: free is not a no-op\n");
+            goto done;
+        }
+
+        large = njs_mp_alloc(mp, 3 * 4096);
+        if (large == NULL) {
+            goto done;
+        }
+
+        njs_mp_reset(mp);
+
+        njs_mp_stat(mp, &stat);
+
+        if (stat.nblocks != start.nblocks || stat.size != start.size) {
+            njs_printf("mp nursery unit test failed: after reset "
+                       "%uz bytes in %uz blocks\n", stat.size, stat.nblocks);
+            goto done;
+        }
+
+        p = njs_mp_alloc(mp, size);
+        if (p != first) {
+            njs_printf("mp nursery unit test failed: "
+                       "nursery is not rewound: %p\n", p);
+            goto done;
+        }
+
+        njs_mp_reset(mp);
+    }
+
+    /* The exhausted nursery falls back to clusters. */
+
+    for (i = 0; i < nursery_size / size; i++) {
+        if (njs_mp_alloc(mp, size) == NULL) {
+            goto done;
+        }
+    }
+
+    for (i = 0; i < 3 * (4096 / size); i++) {
+        p = njs_mp_alloc(mp, size);
+        if (p == NULL) {
+            goto done;
+        }
+
+        if (p >= first && p < first + nursery_size) {
+            njs_printf("mp nursery unit test failed: "
+                       "chunk %p is in the exhausted nursery\n", p);
+            goto done;
+        }
+    }
+
+    njs_mp_stat(mp, &stat);
+
+    if (stat.nblocks != start.nblocks + 3
+        || stat.size != start.size + 3 * stat.cluster_size)
+    {
+        njs_printf("mp nursery unit test failed: "
+                   "%uz bytes in %uz blocks\n", stat.size, stat.nblocks);
+        goto done;
+    }
+
+    /* Clusters are kept by a reset, the nursery is used first again. */
+
+    njs_mp_reset(mp);
+
+    if (njs_mp_alloc(mp, size) != first) {
+        njs_printf("mp nursery unit test failed: "
+                   "nursery is not rewound after clusters\n");
+        goto done;
+    }
+
+    ret = NJS_OK;
+
+    njs_printf("mp nursery unit test passed\n");
+
+done:
+
+    njs_mp_destroy(mp);
+
+    return ret;
+}
+
+#endif
+
+
+static int njs_cdecl
+mp_unit_test_sort_cmp(const void *one, const void *two, void *ctx)
+{
+    const mp_unit_test_item_t  *item1, *item2;
+
+    item1 = one;
+    item2 = two;
+
+    if (item1->p < item2->p) {
+        return -1;
+    }
+
+    return (item1->p > item2->p);
+}
+
+
+int
+main(void)
+{
+    if (mp_unit_test_interleaved(64 * 1024) != NJS_OK) {
+        return NJS_ERROR;
+    }
+
+    if (mp_unit_test_boundaries(4096, 1024) != NJS_OK
+        || mp_unit_test_boundaries(4096, 32) != NJS_OK
+        || mp_unit_test_boundaries(3072, 1024) != NJS_OK
+        || mp_unit_test_boundaries(3072, 32) != NJS_OK)
+    {
+        return NJS_ERROR;
+    }
+
+    if (mp_unit_test_mixed(64 * 1024) != NJS_OK) {
+        return NJS_ERROR;
+    }
+
+#if !(NJS_DEBUG_MEMORY)
+
+    if (mp_unit_test_invalid_free() != NJS_OK) {
+        return NJS_ERROR;
+    }
+
+    if (mp_unit_test_nursery() != NJS_OK) {
+        return NJS_ERROR;
+    }
+
+#endif
+
+    return NJS_OK;
+}
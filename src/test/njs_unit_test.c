@@ -987,6 +987,36 @@ static njs_unit_test_t  njs_test[] =
     { njs_str("1 + 1 + '2' + 1 + 1"),
       njs_str("2211") },
 
+    { njs_str("'2' + 1 + 1 * 3 - 2"),
+      njs_str("211") },
+
+    { njs_str("function f(a, b) { return a + b }"
+              "[f(1, 2), f('1', 2), f(1, 2), f(1, {}), f(true, null), f(1, 2)]"),
+      njs_str("3,12,3,1[object Object],1,3") },
+
+    { njs_str("function f(a, b) { return [a < b, a > b, a <= b, a >= b] }"
+              "[f(1, 2), f('10', '9'), f(1, NaN), f(2, 2), f('a', 1)]"
+              ".map(v => v.map(Number).join('')).join()"),
+      njs_str("1010,1010,0000,0011,0000") },
+
+    { njs_str("function f(a, b) { var n = 0;"
+              "                    if (a < b) n += 1; if (a > b) n += 2;"
+              "                    if (a <= b) n += 4; if (a >= b) n += 8;"
+              "                    return n }"
+              "[f(1, 2), f(2, 1), f('10', '9'), f(NaN, 1), f(2, 2),"
+              " f({valueOf() { return 3 }}, 2), f(1, 2)]"),
+      njs_str("5,10,5,0,12,10,5") },
+
+    { njs_str("var a = [1, 2, '3', 4, {valueOf() { return 5 }}], i, s = 0;"
+              "for (i = 0; i < a.length; i++) { if (a[i] > 1) s += i } s"),
+      njs_str("10") },
+
+    { njs_str("[60 * 60 * 1000, 7 % -3, -7 % 3, 1 / 0, -1 / 0, 1 / -0]"),
+      njs_str("3600000,1,-1,Infinity,-Infinity,-Infinity") },
+
+    { njs_str("[0 / 0, 5 % 0, 1 - 1, 0 * -1, 1 / (0 * -1)]"),
+      njs_str("NaN,NaN,0,0,-Infinity") },
+
     { njs_str("'gg' + -0"),
       njs_str("gg0") },
 
@@ -3195,6 +3225,22 @@ static njs_unit_test_t  njs_test[] =
     { njs_str("var i = 0; while (i < 100) if (i++ > 9) break; i"),
       njs_str("11") },
 
+    { njs_str("var i = 0; while (1) { if (i++ > 9) break; } i"),
+      njs_str("11") },
+
+    { njs_str("var i = 0; while (0) { i++ } i"),
+      njs_str("0") },
+
+    { njs_str("var i = 0; do { i++ } while (''); i"),
+      njs_str("1") },
+
+    { njs_str("var i = 0; for (;'a';) { if (i++ > 4 && i > 5) break; } i"),
+      njs_str("6") },
+
+    { njs_str("var i = 0, a = 0;"
+              "for (; i < 10; i++) { if (i > 2 || i < 1) continue; a++ } a"),
+      njs_str("2") },
+
     { njs_str("for ( ;; ) break"),
       njs_str("undefined") },
 
@@ -4065,6 +4111,93 @@ static njs_unit_test_t  njs_test[] =
                  "var c = new Cl('a', 'b'); Cl.prototype.z = 1; c.z"),
       njs_str("1") },
 
+    /* Property cache. */
+
+    { njs_str("function f(o) {return o.a}; var r = [];"
+              "for (var i = 0; i < 6; i++) {"
+              "    var o = {a:i}; r.push(f(o), f(o)) }"
+              "r.join()"),
+      njs_str("0,0,1,1,2,2,3,3,4,4,5,5") },
+
+    { njs_str("var o = {a:1}; var r = [];"
+              "for (var i = 0; i < 3; i++) {"
+              "    r.push(o.a); if (i == 1) { delete o.a } }"
+              "r.join()"),
+      njs_str("1,1,") },
+
+    { njs_str("var o = {a:1, b:2}; var r = [];"
+              "for (var i = 0; i < 4; i++) {"
+              "    r.push(o.a); if (i == 1) { delete o.a; o.a = 3 } }"
+              "r.join()"),
+      njs_str("1,1,3,3") },
+
+    { njs_str("var o = {a:1}; var r = [];"
+              "for (var i = 0; i < 3; i++) { r.push(o.a); if (i == 1) {"
+              "    Object.defineProperty(o, 'a', {get() {return 'g'}}) } }"
+              "r.join()"),
+      njs_str("1,1,g") },
+
+    { njs_str("var o = {a:1}; var r = [];"
+              "for (var i = 0; i < 3; i++) { if (i == 2) { Object.freeze(o) }"
+              "    try { o.a = i } catch (e) { r.push(e.name) } r.push(o.a) }"
+              "r.join()"),
+      njs_str("0,1,TypeError,1") },
+
+    { njs_str("var o = {}; var r = [];"
+              "for (var i = 0; i < 20; i++) {"
+              "    o['k' + i] = i; o.k0 = o.k0 + 1; r.push(o.k0) }"
+              "r.join()"),
+      njs_str("1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20") },
+
+    { njs_str("var p = {a:1}; var o = Object.create(p); var r = [];"
+              "for (var i = 0; i < 3; i++) { r.push(o.a); o.a = 'own' + i }"
+              "r.push(p.a); r.join()"),
+      njs_str("1,own0,own1,1") },
+
+    { njs_str("var a = [1,2]; a.length = 2; var r = [];"
+              "for (var i = 0; i < 3; i++) { a.length = i; r.push(a.length) }"
+              "r.join()"),
+      njs_str("0,1,2") },
+
+    { njs_str("var o = {aVeryLongPropertyName: 1};"
+              "o['aVeryLong' + 'PropertyName'] += 1;"
+              "o.aVeryLongPropertyName + o['aVeryLong' + 'PropertyName']"),
+      njs_str("4") },
+
+    { njs_str("var o = {}; o['x' + 1] = 1; o.x1++; ++o['x' + 1];"
+              "o.x1 += o.x1; [o.x1, Object.keys(o)].join()"),
+      njs_str("6,x1") },
+
+    /* Object literal shapes. */
+
+    { njs_str("function f(v) {return {a:v, b:2, a:v + 1}}"
+              "var o = f(1); Object.keys(f(2)) + ':' + o.a + o.b"),
+      njs_str("a,b:22") },
+
+    { njs_str("var k = 'c'; var o = {a:1, [k]:2, b:3, 1:4, '0':5};"
+              "Object.keys(o)"),
+      njs_str("0,1,a,c,b") },
+
+    { njs_str("function f(v) {return {x:v, get y() {return this.x * 2}}}"
+              "var r = [];"
+              "for (var i = 0; i < 3; i++) { var o = f(i); r.push(o.y) }"
+              "r.join()"),
+      njs_str("0,2,4") },
+
+    { njs_str("var r = [];"
+              "for (var i = 0; i < 4; i++) { var o = {x:i, y:i * 2};"
+              "    if (i == 1) { delete o.x } if (i == 2) { o.z = 1 }"
+              "    r.push(o.x, o.y) }"
+              "r.join()"),
+      njs_str("0,0,,2,2,4,3,6") },
+
+    { njs_str("var r = [];"
+              "for (var i = 0; i < 3; i++) { var o = {a:i, b:i};"
+              "    if (i == 1) { Object.freeze(o) }"
+              "    try { o.b = 'b' } catch (e) {} r.push(o.a + o.b) }"
+              "r.join()"),
+      njs_str("0b,2,2b") },
+
     /**/
 
     { njs_str("delete Math.E"),
@@ -8135,6 +8268,19 @@ static njs_unit_test_t  njs_test[] =
                  "String.prototype.concat.apply(s, a.slice(1))"),
       njs_str("RangeError: invalid string length") },
 
+    { njs_str("var s = ''; for (var i = 0; i < 1000; i++) { s += 'abcdefghij' }"
+              "[s.length, s.slice(-12), s.indexOf('ja')]"),
+      njs_str("10000,ijabcdefghij,9") },
+
+    { njs_str("var a = 'x'.repeat(20) + 'y' + 'z';"
+              "var b = a + 'b'; var c = a + 'c'; var d = b + 'd';"
+              "[a.slice(-3), b.slice(-3), c.slice(-3), d.slice(-3)]"),
+      njs_str("xyz,yzb,yzc,zbd") },
+
+    { njs_str("var a = 'x'.repeat(20) + 'y' + 'z'; var b = a + 'α';"
+              "var c = a + 'c'; [b.slice(-2), b.length, c.slice(-2)]"),
+      njs_str("zα,23,zc") },
+
     { njs_str("var a = 'abcdefgh'; a.substr(3, 15)"),
       njs_str("defgh") },
 
@@ -8153,6 +8299,20 @@ static njs_unit_test_t  njs_test[] =
     { njs_str("('abc' + 'defgh').substr(1, 4)"),
       njs_str("bcde") },
 
+    { njs_str("var s = 'abcdefghijklmnopqrstuvwxyz'.repeat(4);"
+              "var v = s.slice(26, 80); s += '!';"
+              "v += v.substring(1, 40); [v.length, v.slice(-5), s.slice(-3)]"),
+      njs_str("93,jklmn,yz!") },
+
+    { njs_str("var s = ''; for (var i = 0; i < 10; i++) { s += 'x' + i + '-'; }"
+              "var v = s.substr(3, 18); s += 'tail';"
+              "[v, v.length, s.slice(-6)]"),
+      njs_str("x1-x2-x3-x4-x5-x6-,18,9-tail") },
+
+    { njs_str("var p = ('abcdefghij'.repeat(3) + '|').repeat(3).split('|');"
+              "[p.length, p[1].length, p[2].slice(25), p[3]]"),
+      njs_str("4,30,fghij,") },
+
     { njs_str("'abcdefghijklmno'.substring(3, 5)"),
       njs_str("de") },
 
@@ -8517,6 +8677,14 @@ static njs_unit_test_t  njs_test[] =
     { njs_str("'12'.indexOf('12345')"),
       njs_str("-1") },
 
+    { njs_str("var s = 'aab aabaab абаб';"
+              "[s.indexOf('aab', 1), s.indexOf('aabx'), s.indexOf('баб'),"
+              " s.indexOf('б', 14), s.includes('baab', 5), s.indexOf('b', 14)]"),
+      njs_str("4,-1,12,14,true,-1") },
+
+    { njs_str("'a;;b;c;;'.split(';;')"),
+      njs_str("a,b;c,") },
+
     { njs_str("''.indexOf.call(12345, 45, '0')"),
       njs_str("3") },
 
@@ -11850,6 +12018,14 @@ static njs_unit_test_t  njs_test[] =
               "re.lastIndex = 67; re.lastIndex"),
       njs_str("67") },
 
+    { njs_str("var r = [/(a)(b)?/, /(a)(b)(c)(d)(e)/, /(x)?a/, /(a)(b)(c)(d)(e)(f)/];"
+              "r.map(re => re.exec('abcdef')).join('|')"),
+      njs_str("ab,a,b|abcde,a,b,c,d,e|a,|abcdef,a,b,c,d,e,f") },
+
+    { njs_str("var m = /(a|b)*c/.exec('ab'.repeat(200000) + 'c');"
+              "[m[0].length, m[1]]"),
+      njs_str("400001,b") },
+
     { njs_str("var re = /a/; re.lastIndex = 4; Object.create(re).lastIndex"),
       njs_str("4") },
 
@@ -18280,6 +18456,15 @@ static njs_unit_test_t  njs_test[] =
     { njs_str("JSON.parse('\"\\\\q\"')"),
       njs_str("SyntaxError: Unknown escape char at position 2") },
 
+    { njs_str("JSON.parse('\"abcdefghijklmnop\\\\\"qrstuvw\\\\\\\\xyz0123456789\"')"),
+      njs_str("abcdefghijklmnop\"qrstuvw\\xyz0123456789") },
+
+    { njs_str("JSON.parse('\"abcdefghij\\x01\"')"),
+      njs_str("SyntaxError: Forbidden source char at position 11") },
+
+    { njs_str("JSON.parse('\"abcdefghijklmnopq')"),
+      njs_str("SyntaxError: Unexpected end of input at position 18") },
+
     { njs_str("JSON.parse('\"\\\\uDC01\"')"),
       njs_str("�") },
 
@@ -18391,6 +18576,28 @@ static njs_unit_test_t  njs_test[] =
     { njs_str("JSON.parse('[2,3,43]', (k, v) => {if (v == 43) {throw 'Oops'}; return v;})"),
       njs_str("Oops") },
 
+    { njs_str("var s = JSON.stringify({a:{b:[1,{c:2}]}, d:[{e:{f:3}}], g:'abcdefghijklmnop'});"
+              "var o = JSON.parse(s, {lazy:true});"
+              "[o.a === o.a, o.a.b[1].c, o.d[0].e.f, Object.keys(o), JSON.stringify(o) === s]"),
+      njs_str("true,2,3,a,d,g,true") },
+
+    { njs_str("var o = JSON.parse('{\"a\":{\"b\":1},\"c\":[1,2],\"dddddddd\":0}', {lazy:true});"
+              "o.a = 1; delete o.c; JSON.stringify(o)"),
+      njs_str("{\"a\":1,\"dddddddd\":0}") },
+
+    { njs_str("var p = JSON.parse('{\"a\":{\"b\":1},\"c\":[1,2],\"dddddddd\":0}', {lazy:true});"
+              "var o = Object.create(p); o.c = 2;"
+              "[o.a.b, o.a === p.a, o.c, p.c]"),
+      njs_str("1,true,2,1,2") },
+
+    { njs_str("var p = JSON.parse('{\"a\":{\"b\":1},\"c\":[1,2],\"dddddddd\":0}', {lazy:true});"
+              "Object.setPrototypeOf(Number.prototype, p);"
+              "[(1).a.b, (1).a === p.a, Object.getOwnPropertyDescriptor(p, 'c').value]"),
+      njs_str("1,true,1,2") },
+
+    { njs_str("JSON.parse('{\"a\":{\"b\":[1,2,]},\"c\":\"dddddddd\"}', {lazy:true})"),
+      njs_str("SyntaxError: Trailing comma at position 14") },
+
     /* JSON.stringify() */
 
     { njs_str("JSON.stringify()"),
@@ -18599,6 +18806,13 @@ static njs_unit_test_t  njs_test[] =
     { njs_str("JSON.stringify('абв'.repeat(100)).length"),
       njs_str("302") },
 
+    { njs_str("JSON.stringify('abcdefg\"hijklmn\\\\opqrstu\\nабв')"),
+      njs_str("\"abcdefg\\\"hijklmn\\\\opqrstu\\nабв\"") },
+
+    { njs_str("var s = JSON.stringify(Array(1000).fill('x'.repeat(15) + '\"'));"
+              "[s.length, JSON.parse(s)[999].length]"),
+      njs_str("20001,16") },
+
     /* Optional arguments. */
 
     { njs_str("JSON.stringify(undefined, undefined, 1)"),
@@ -19458,6 +19672,19 @@ static njs_unit_test_t  njs_test[] =
               "de.decode(new Uint8Array([240, 160]))"),
       njs_str("�") },
 
+    { njs_str("var de = new TextDecoder();"
+              "var b = Array.from('abcdefghij').map(c=>c.charCodeAt(0));"
+              "var s = de.decode(new Uint8Array(b.concat([195, 169], b, [255],"
+              "                                          b.slice(3))));"
+              "[s, s.length, s.charAt(10), s.indexOf('k')]"),
+      njs_str("abcdefghijéabcdefghij�defghij,29,é,-1") },
+
+    { njs_str("var de = new TextDecoder();"
+              "de.decode(new Uint8Array([97, 98, 195]), {stream: 1})"
+              "+ de.decode(new Uint8Array([169, 97, 98, 99, 100, 101, 102, 103,"
+              "                            104, 105, 106]))"),
+      njs_str("abéabcdefghij") },
+
     { njs_str("var en = new TextEncoder();"
               "var de = new TextDecoder('utf-8', {ignoreBOM: true});"
               "en.encode(de.decode(new Uint8Array([239, 187, 191, 50])))"),
@@ -23749,6 +23976,492 @@ njs_string_to_index_test(njs_vm_t *vm, njs_opts_t *opts, njs_stat_t *stat)
 }
 
 
+static njs_int_t
+njs_vm_recycle_test(njs_vm_t *vm, njs_opts_t *opts, njs_stat_t *stat)
+{
+    u_char              *start;
+    njs_vm_t            *nvm;
+    njs_str_t           s;
+    njs_int_t           ret;
+    njs_uint_t          i;
+    njs_opaque_value_t  retval;
+
+    static const njs_str_t  script = njs_str(
+        "globalThis.n = (globalThis.n || 0) + 1;"
+        "Array.prototype.n = n; var a = new Array(1000).fill('x');"
+        "[n, [].n, a.length].join()");
+
+    static const njs_str_t  expected = njs_str("1,1,1000");
+
+    start = script.start;
+
+    ret = njs_vm_compile(vm, &start, start + script.length);
+    if (ret != NJS_OK) {
+        njs_printf("njs_vm_recycle_test: njs_vm_compile() failed\n");
+        return NJS_ERROR;
+    }
+
+    nvm = njs_vm_clone(vm, NULL);
+    if (nvm == NULL) {
+        njs_printf("njs_vm_recycle_test: njs_vm_clone() failed\n");
+        return NJS_ERROR;
+    }
+
+    for (i = 0; i < 3; i++) {
+        if (i != 0) {
+            nvm = njs_vm_recycle(vm, nvm, NULL);
+            if (nvm == NULL) {
+                njs_printf("njs_vm_recycle_test: njs_vm_recycle() failed\n");
+                return NJS_ERROR;
+            }
+        }
+
+        ret = njs_vm_start(nvm, njs_value_arg(&retval));
+        if (ret != NJS_OK
+            || njs_vm_value_string(nvm, &s, njs_value_arg(&retval)) != NJS_OK)
+        {
+            njs_printf("njs_vm_recycle_test: njs_vm_start() failed\n");
+            njs_vm_destroy(nvm);
+            return NJS_ERROR;
+        }
+
+        if (!njs_strstr_eq(&expected, &s)) {
+            njs_printf("njs_vm_recycle_test(%ui):\n"
+                       "expected: \"%V\"\n     got: \"%V\"\n",
+                       i, &expected, &s);
+
+            stat->failed++;
+            continue;
+        }
+
+        stat->passed++;
+    }
+
+    njs_vm_destroy(nvm);
+
+    return NJS_OK;
+}
+
+
+static njs_int_t
+njs_vm_memory_limit_test(njs_vm_t *vm, njs_opts_t *opts, njs_stat_t *stat)
+{
+    u_char              *start;
+    njs_vm_t            *nvm;
+    njs_str_t           s;
+    njs_int_t           ret;
+    njs_uint_t          i, n;
+    njs_function_t      *func;
+    njs_mp_stat_t       mp_stat;
+    njs_opaque_value_t  retval;
+
+    static const njs_str_t  script = njs_str(
+        "function run(f) {"
+        "    var a = [];"
+        "    try { for (var i = 0; ; i++) { f(a, i); } }"
+        "    catch (e) { return [String(e), internal()].join(); }"
+        "}"
+        "function internal() {"
+        "    try { Math.max.apply(null, {length: 2048}); }"
+        "    catch (e) { return e.name; }"
+        "}"
+        "function strings() {"
+        "    return run((a, i) => a.push('x'.repeat(4096) + i));"
+        "}"
+        "function objects() {"
+        "    return run((a, i) => a.push({['k' + i]: i, v: [i, String(i)]}));"
+        "}"
+        "function regexps() {"
+        "    return run((a, i) => {"
+        "        var s = 'ab'.repeat(64) + i;"
+        "        a.push(s.replace(/(a)(b)/g, '$2$1'), /(a|b)+(\\d+)/.exec(s));"
+        "    });"
+        "}"
+        "function json() {"
+        "    return run((a, i) => a.push(JSON.parse(JSON.stringify({i, a: [i]}))));"
+        "}");
+
+    static const njs_str_t  workloads[] = {
+        njs_str("strings"),
+        njs_str("objects"),
+        njs_str("regexps"),
+        njs_str("json"),
+    };
+
+    /* Other errors are reported as usual after a MemoryError. */
+
+    static const njs_str_t  expected = njs_str("MemoryError,InternalError");
+
+    start = script.start;
+
+    ret = njs_vm_compile(vm, &start, start + script.length);
+    if (ret != NJS_OK) {
+        njs_printf("njs_vm_memory_limit_test: njs_vm_compile() failed\n");
+        return NJS_ERROR;
+    }
+
+    for (n = 0; n < njs_nitems(workloads); n++) {
+        for (i = 0; i < 2; i++) {
+            nvm = njs_vm_clone(vm, NULL);
+            if (nvm == NULL) {
+                njs_printf("njs_vm_memory_limit_test: "
+                           "njs_vm_clone() failed\n");
+                return NJS_ERROR;
+            }
+
+            njs_mp_stat(njs_vm_memory_pool(nvm), &mp_stat);
+
+            /* Without a soft limit a fifth of the hard limit is reserved. */
+
+            njs_mp_limit(njs_vm_memory_pool(nvm),
+                         (i == 0) ? mp_stat.size + 512 * 1024 : 0,
+                         mp_stat.size + 1024 * 1024);
+
+            ret = njs_vm_start(nvm, njs_value_arg(&retval));
+            if (ret != NJS_OK) {
+                njs_printf("njs_vm_memory_limit_test: "
+                           "njs_vm_start() failed\n");
+                goto fail;
+            }
+
+            func = njs_vm_function(nvm, &workloads[n]);
+            if (func == NULL) {
+                njs_printf("njs_vm_memory_limit_test: "
+                           "njs_vm_function() failed\n");
+                goto fail;
+            }
+
+            ret = njs_vm_invoke(nvm, func, NULL, 0, njs_value_arg(&retval));
+            if (ret != NJS_OK) {
+                njs_vm_exception_string(nvm, &s);
+
+            } else {
+                ret = njs_vm_value_string(nvm, &s, njs_value_arg(&retval));
+                if (ret != NJS_OK) {
+                    njs_printf("njs_vm_memory_limit_test: "
+                               "njs_vm_value_string() failed\n");
+                    goto fail;
+                }
+            }
+
+            if (ret != NJS_OK || !njs_strstr_eq(&expected, &s)) {
+                njs_printf("njs_vm_memory_limit_test(%V, %ui):\n"
+                           "expected: \"%V\"\n     got: %s\"%V\"\n",
+                           &workloads[n], i, &expected,
+                           (ret != NJS_OK) ? "uncaught " : "", &s);
+
+                stat->failed++;
+
+            } else {
+                stat->passed++;
+            }
+
+            njs_vm_destroy(nvm);
+        }
+    }
+
+    return NJS_OK;
+
+fail:
+
+    njs_vm_destroy(nvm);
+
+    return NJS_ERROR;
+}
+
+
+static njs_int_t
+njs_vm_string_external_test(njs_vm_t *vm, njs_opts_t *opts, njs_stat_t *stat)
+{
+    size_t              length;
+    njs_int_t           ret;
+    njs_uint_t          i;
+    njs_string_prop_t   prop;
+    njs_opaque_value_t  value;
+
+    static const struct {
+        njs_str_t   data;
+        njs_bool_t  shared;
+        size_t      length;
+    } tests[] = {
+        { njs_str("short"), 0, 5 },
+        { njs_str("/a/long/request/uri?arg=1"), 1, 25 },
+        { njs_str("значение заголовка"), 1, 18 },
+        { njs_str("invalid \xff utf-8 value"), 0, 21 },
+    };
+
+    for (i = 0; i < njs_nitems(tests); i++) {
+        ret = njs_vm_value_string_external(vm, njs_value_arg(&value),
+                                           tests[i].data.start,
+                                           tests[i].data.length);
+        if (ret != NJS_OK) {
+            njs_printf("njs_vm_string_external_test: "
+                       "njs_vm_value_string_external() failed\n");
+            return NJS_ERROR;
+        }
+
+        length = njs_string_prop(&prop, njs_value_arg(&value));
+
+        if (length != tests[i].length
+            || (prop.start == tests[i].data.start) != tests[i].shared)
+        {
+            njs_printf("njs_vm_string_external_test(\"%V\"):\n"
+                       "expected: %z shared:%d\n     got: %z shared:%d\n",
+                       &tests[i].data, tests[i].length, tests[i].shared,
+                       length, prop.start == tests[i].data.start);
+
+            stat->failed++;
+            continue;
+        }
+
+        stat->passed++;
+    }
+
+    return NJS_OK;
+}
+
+
+static njs_int_t
+njs_vm_string_intern_test(njs_vm_t *vm, njs_opts_t *opts, njs_stat_t *stat)
+{
+    u_char              *start;
+    njs_int_t           ret;
+    njs_uint_t          i;
+    njs_str_t           s1, s2;
+    njs_bool_t          shared;
+    njs_opaque_value_t  value1, value2;
+    njs_int_t           (*create)(njs_vm_t *vm, njs_value_t *value,
+                                  const u_char *start, uint32_t size);
+
+    static const njs_str_t  script = njs_str("'x-request-id-header'");
+
+    static const struct {
+        njs_str_t   data;
+        njs_bool_t  intern;
+        njs_bool_t  shared;
+    } tests[] = {
+        { njs_str("x-request-id-header"), 1, 1 },
+        { njs_str("application/json; charset=utf-8"), 1, 1 },
+        { njs_str("значение"), 1, 1 },
+        { njs_str("invalid \xff utf-8 value"), 1, 0 },
+        { njs_str("a string which is too long to be interned by the VM, "
+                  "66 bytes long"), 1, 0 },
+
+        /* Strings are not interned by njs_vm_value_string_create(). */
+
+        { njs_str("application/octet-stream"), 0, 0 },
+    };
+
+    start = script.start;
+
+    ret = njs_vm_compile(vm, &start, start + script.length);
+    if (ret != NJS_OK) {
+        njs_printf("njs_vm_string_intern_test: njs_vm_compile() failed\n");
+        return NJS_ERROR;
+    }
+
+    ret = njs_vm_start(vm, njs_value_arg(&value1));
+    if (ret != NJS_OK) {
+        njs_printf("njs_vm_string_intern_test: njs_vm_start() failed\n");
+        return NJS_ERROR;
+    }
+
+    for (i = 0; i < njs_nitems(tests); i++) {
+        create = tests[i].intern ? njs_vm_value_string_intern
+                                 : njs_vm_value_string_create;
+
+        if (i != 0) {
+            ret = create(vm, njs_value_arg(&value1), tests[i].data.start,
+                         tests[i].data.length);
+            if (ret != NJS_OK) {
+                goto failed;
+            }
+        }
+
+        ret = create(vm, njs_value_arg(&value2), tests[i].data.start,
+                     tests[i].data.length);
+        if (ret != NJS_OK) {
+            goto failed;
+        }
+
+        njs_value_string_get(njs_value_arg(&value1), &s1);
+        njs_value_string_get(njs_value_arg(&value2), &s2);
+
+        shared = (s1.start == s2.start);
+
+        if (shared != tests[i].shared || !njs_strstr_eq(&s1, &s2)) {
+            njs_printf("njs_vm_string_intern_test(\"%V\"):\n"
+                       "expected: shared:%d\n     got: shared:%d\n",
+                       &tests[i].data, tests[i].shared, shared);
+
+            stat->failed++;
+            continue;
+        }
+
+        stat->passed++;
+    }
+
+    return NJS_OK;
+
+failed:
+
+    njs_printf("njs_vm_string_intern_test: "
+               "string creation failed\n");
+
+    return NJS_ERROR;
+}
+
+
+typedef struct {
+    njs_chb_t   chain;
+    njs_uint_t  chunks;
+} njs_json_writer_test_t;
+
+
+static njs_int_t
+njs_json_writer_test(njs_vm_t *vm, const u_char *start, size_t size,
+    void *data)
+{
+    njs_json_writer_test_t  *writer;
+
+    writer = data;
+
+    njs_chb_append(&writer->chain, start, size);
+    writer->chunks++;
+
+    return NJS_OK;
+}
+
+
+static njs_int_t
+njs_vm_json_stringify_to_test(njs_vm_t *vm, njs_opts_t *opts,
+    njs_stat_t *stat)
+{
+    u_char                  *start;
+    int64_t                 n, length;
+    njs_vm_t                *nvm;
+    njs_int_t               ret;
+    njs_str_t               s1, s2;
+    njs_uint_t              i;
+    njs_value_t             *value;
+    njs_opaque_value_t      values, args[3], retval;
+    njs_json_writer_test_t  writer;
+
+    static const njs_str_t  script =
+        njs_str("[{a: Array(3000).fill({key: 'value', n: 1.5, s: 'x\\\"y'}),"
+                "  b: 'end'},"
+                " {a: 1, b: [2, 3]}, [1, 2, 3], {}, [],"
+                " 'abcdefghijklmnopqrstuvwxyz', 42, true, null, undefined]");
+
+    static const double  indent[] = { 0, 2 };
+
+    start = script.start;
+
+    ret = njs_vm_compile(vm, &start, start + script.length);
+    if (ret != NJS_OK) {
+        njs_printf("njs_vm_json_stringify_to_test: "
+                   "njs_vm_compile() failed\n");
+        return NJS_ERROR;
+    }
+
+    nvm = njs_vm_clone(vm, NULL);
+    if (nvm == NULL) {
+        njs_printf("njs_vm_json_stringify_to_test: njs_vm_clone() failed\n");
+        return NJS_ERROR;
+    }
+
+    ret = njs_vm_start(nvm, njs_value_arg(&values));
+    if (ret != NJS_OK) {
+        njs_printf("njs_vm_json_stringify_to_test: "
+                   "njs_vm_start() failed\n");
+        goto done;
+    }
+
+    ret = njs_vm_array_length(nvm, njs_value_arg(&values), &length);
+    if (ret != NJS_OK) {
+        njs_printf("njs_vm_json_stringify_to_test: "
+                   "njs_vm_array_length() failed\n");
+        goto done;
+    }
+
+    njs_value_undefined_set(njs_value_arg(&args[1]));
+
+    for (n = 0; n < length; n++) {
+        value = njs_vm_array_prop(nvm, njs_value_arg(&values), n, &retval);
+        if (value == NULL) {
+            njs_printf("njs_vm_json_stringify_to_test: "
+                       "njs_vm_array_prop() failed\n");
+            ret = NJS_ERROR;
+            goto done;
+        }
+
+        njs_value_assign(&args[0], value);
+
+        for (i = 0; i < njs_nitems(indent); i++) {
+            njs_value_number_set(njs_value_arg(&args[2]), indent[i]);
+
+            ret = njs_vm_json_stringify(nvm, njs_value_arg(args), 3,
+                                        njs_value_arg(&retval));
+            if (ret != NJS_OK) {
+                njs_printf("njs_vm_json_stringify_to_test: "
+                           "njs_vm_json_stringify() failed\n");
+                goto done;
+            }
+
+            NJS_CHB_MP_INIT(&writer.chain, nvm);
+            writer.chunks = 0;
+
+            ret = njs_vm_json_stringify_to(nvm, njs_value_arg(args), 3,
+                                           njs_json_writer_test, &writer);
+            if (ret != NJS_OK) {
+                njs_printf("njs_vm_json_stringify_to_test: "
+                           "njs_vm_json_stringify_to() failed\n");
+                goto done;
+            }
+
+            ret = njs_chb_join(&writer.chain, &s2);
+            if (ret != NJS_OK) {
+                njs_printf("njs_vm_json_stringify_to_test: "
+                           "njs_chb_join() failed\n");
+                goto done;
+            }
+
+            njs_chb_destroy(&writer.chain);
+
+            if (njs_value_is_undefined(njs_value_arg(&retval))) {
+                s1 = njs_str_value("");
+
+            } else {
+                njs_value_string_get(njs_value_arg(&retval), &s1);
+            }
+
+            /* Only the first value is large enough to be flushed twice. */
+
+            if ((n == 0 && writer.chunks < 2) || !njs_strstr_eq(&s1, &s2)) {
+                njs_printf("njs_vm_json_stringify_to_test(%L, %d):\n"
+                           "expected: \"%*s\" size:%uz\n"
+                           "     got: \"%*s\" size:%uz chunks:%ui\n",
+                           n, (int) indent[i],
+                           njs_min(s1.length, 64), s1.start, s1.length,
+                           njs_min(s2.length, 64), s2.start, s2.length,
+                           writer.chunks);
+
+                stat->failed++;
+                continue;
+            }
+
+            stat->passed++;
+        }
+    }
+
+done:
+
+    njs_vm_destroy(nvm);
+
+    return ret;
+}
+
+
 #ifdef NJS_HAVE_ADDR2LINE
 static njs_int_t
 njs_addr2line_test(njs_vm_t *vm, njs_opts_t *opts, njs_stat_t *stat)
@@ -23808,6 +24521,16 @@ njs_vm_internal_api_test(njs_unit_test_t unused[], size_t num, njs_str_t *name,
           njs_str("njs_sort_test") },
         { njs_string_to_index_test,
           njs_str("njs_string_to_index_test") },
+        { njs_vm_recycle_test,
+          njs_str("njs_vm_recycle_test") },
+        { njs_vm_memory_limit_test,
+          njs_str("njs_vm_memory_limit_test") },
+        { njs_vm_string_external_test,
+          njs_str("njs_vm_string_external_test") },
+        { njs_vm_string_intern_test,
+          njs_str("njs_vm_string_intern_test") },
+        { njs_vm_json_stringify_to_test,
+          njs_str("njs_vm_json_stringify_to_test") },
 #ifdef NJS_HAVE_ADDR2LINE
         { njs_addr2line_test,
           njs_str("njs_addr2line_test") },
@@ -431,6 +431,20 @@ interface NginxHTTPRequest {
      * an incoming data chunk buffer.
      */
     sendBuffer(data: NjsStringOrBuffer, options?: NginxHTTPSendBufferOptions): void;
+    /**
+     * Sends a value serialized as JSON as a part of the response body
+     * to the client. The same as `r.send(JSON.stringify(value, replacer, space))`,
+     * but the output is passed to nginx in parts of about 16K as it is
+     * produced, without building the whole string. Response buffers are
+     * reused once they are sent, so the memory used does not grow with
+     * the output size while the client keeps up.
+     *
+     * @since 0.8.6
+     * @param value A value to serialize.
+     * @param replacer A function or an array of keys, see JSON.stringify().
+     * @param space Indentation, see JSON.stringify().
+     */
+    sendJSON(value: any, replacer?: any, space?: string | number): void;
     /**
      * Sends the HTTP headers to the client.
      */